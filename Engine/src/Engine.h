@@ -12,17 +12,26 @@
 
 #include "Engine/ImGui/ImGuiLayer.h"
 
+#include "Engine/Core/StringId.h"
 #include "Engine/Core/Timestep.h"
 
 // ---Renderer ------------------
 #include "Engine/Renderer/Buffer.h"
+#include "Engine/Renderer/Font.h"
+#include "Engine/Renderer/GPUParticleSystem.h"
 #include "Engine/Renderer/GraphicsContext.h"
+#include "Engine/Renderer/HotReload.h"
+#include "Engine/Renderer/MeshBuffer.h"
 #include "Engine/Renderer/OrthographicCamera.h"
 #include "Engine/Renderer/OrthographicCameraController.h"
+#include "Engine/Renderer/ParticleSystem.h"
 #include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Renderer/RenderThread.h"
 #include "Engine/Renderer/Renderer.h"
 #include "Engine/Renderer/Renderer2D.h"
 #include "Engine/Renderer/RendererAPI.h"
 #include "Engine/Renderer/Shader.h"
+#include "Engine/Renderer/ShaderPreprocessor.h"
 #include "Engine/Renderer/VertexArray.h"
-#include "Engine/Renderer/Texture.h"
\ No newline at end of file
+#include "Engine/Renderer/Texture.h"
+#include "Engine/Renderer/Tilemap.h"
\ No newline at end of file
@@ -2,6 +2,9 @@
 #include "Application.h"
 
 #include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/RenderThread.h"
+#include "Engine/Renderer/HotReload.h"
+#include "Engine/Core/JobSystem.h"
 #include "Engine/Input.h"
 #include "Engine/ImGui/ImGuiLayer.h"
 #include <GLFW/glfw3.h>
@@ -20,6 +23,7 @@ namespace Engine
 		m_window = std::unique_ptr<Window>(Window::Create());
 		m_window->SetEventCallback(ENGINE_BIND_EVENT_FN(Application::OnEvent));
 
+		JobSystem::Init();
 		Renderer::Init();
 
 		m_imGuiLayer = new ImGuiLayer();
@@ -28,6 +32,33 @@ namespace Engine
 
 	Application::~Application()
 	{
+		RenderThread::Stop();
+		HotReload::Stop();
+		Renderer::ShutDown();
+		JobSystem::ShutDown();
+	}
+
+	void Application::EnableRenderThread(uint32_t framesInFlight)
+	{
+		m_renderThreadFrames = framesInFlight;
+	}
+
+	void Application::DisableRenderThread()
+	{
+		m_renderThreadFrames = 0;
+	}
+
+	void Application::UpdateRenderThread()
+	{
+		if (m_renderThreadFrames && !RenderThread::IsRunning())
+			RenderThread::Start(m_window->GetContext(), m_renderThreadFrames);
+		else if (!m_renderThreadFrames && RenderThread::IsRunning())
+			RenderThread::Stop();
+	}
+
+	void Application::EnableHotReload(uint32_t pollIntervalMilliseconds)
+	{
+		HotReload::Start(pollIntervalMilliseconds);
 	}
 
 	void Application::OnEvent(Event& evnt)
@@ -82,6 +113,23 @@ namespace Engine
 			Timestep timestep = time - m_lastFrameTime;
 			m_lastFrameTime = time;
 
+			UpdateRenderThread();
+			if (RenderThread::IsRunning())
+			{
+				// Events are polled while recording, so resizes record their viewport change
+				RenderThread::BeginFrame();
+				HotReload::Update();
+				m_window->PollEvents();
+				if (!m_minimized)
+				{
+					for (Layer* layer : m_layerStack)
+						layer->OnUpdate(timestep);
+				}
+				RenderThread::EndFrame();
+				continue;
+			}
+
+			HotReload::Update();
 			if (!m_minimized)
 			{
 				for (Layer* layer : m_layerStack)
@@ -27,14 +27,28 @@ namespace Engine
 
 		void PushLayer(Layer* layer);
 		void PushOverlay(Layer* overlay);
+		Layer* FindLayer(StringId name) const { return m_layerStack.Find(name); }
 
 		static Application& Get() { return *s_instance; }
 		Window& GetWindow() { return *m_window; }
+
+		// Records each frame through RenderCommand and replays it on a render thread, with at most
+		// framesInFlight frames queued behind the one being recorded. Layers must then only reach the
+		// GPU through RenderCommand, RenderCommand::Submit and Renderer's direct draws; the other
+		// renderers abort in this mode, see RenderThread. The ImGui overlay is not drawn either.
+		// Both take effect at the start of the next frame, so layers may switch from OnUpdate or OnEvent.
+		void EnableRenderThread(uint32_t framesInFlight = 1);
+		void DisableRenderThread();
+		bool IsRenderThreadEnabled() const { return m_renderThreadFrames > 0; }
+		// Reloads shaders and textures loaded from files when they change on disk, see HotReload
+		void EnableHotReload(uint32_t pollIntervalMilliseconds = 250);
 	protected:
 		static Application* s_instance;
 
 		bool OnWindowClose(WindowCloseEvent& evnt);
 		bool OnWindowResize(WindowResizeEvent& evnt);
+		// Starts or stops the render thread between frames as last asked for
+		void UpdateRenderThread();
 
 		std::unique_ptr<Window> m_window;
 		ImGuiLayer* m_imGuiLayer = nullptr;
@@ -43,6 +57,8 @@ namespace Engine
 		LayerStack m_layerStack;
 
 		float m_lastFrameTime = 0.f;
+		// Frames in flight of the render thread, 0 to render on the main thread
+		uint32_t m_renderThreadFrames = 0;
 	};
 
 	// To be defined in CLIENT
@@ -0,0 +1,78 @@
+#include "engine_pch.h"
+#include "FileWatcher.h"
+
+namespace Engine
+{
+	static std::filesystem::file_time_type GetWriteTime(const std::string& path)
+	{
+		// A file that is missing, for example while an editor replaces it, reads as the minimum time
+		std::error_code error;
+		std::filesystem::file_time_type time = std::filesystem::last_write_time(path, error);
+		return error ? std::filesystem::file_time_type::min() : time;
+	}
+
+	FileWatcher::FileWatcher(uint32_t pollIntervalMilliseconds)
+		:m_PollInterval(pollIntervalMilliseconds)
+	{
+		m_Thread = std::thread(&FileWatcher::Run, this);
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Running = false;
+		}
+		m_StopCondition.notify_one();
+		m_Thread.join();
+	}
+
+	void FileWatcher::Watch(const std::string& path)
+	{
+		std::filesystem::file_time_type time = GetWriteTime(path);
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Files.emplace(path, time);
+	}
+
+	void FileWatcher::Unwatch(const std::string& path)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Files.erase(path);
+	}
+
+	std::vector<std::string> FileWatcher::TakeChanges()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		std::vector<std::string> changes;
+		changes.swap(m_Changes);
+		return changes;
+	}
+
+	void FileWatcher::Run()
+	{
+		std::vector<std::pair<std::string, std::filesystem::file_time_type>> files;
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		while (m_Running)
+		{
+			// The file system is only touched with the lock released
+			files.assign(m_Files.begin(), m_Files.end());
+			lock.unlock();
+			for (auto& file : files)
+				file.second = GetWriteTime(file.first);
+			lock.lock();
+
+			for (auto& file : files)
+			{
+				auto it = m_Files.find(file.first);
+				if (it == m_Files.end() || it->second == file.second)
+					continue;
+
+				it->second = file.second;
+				if (file.second != std::filesystem::file_time_type::min() && std::find(m_Changes.begin(), m_Changes.end(), file.first) == m_Changes.end())
+					m_Changes.push_back(file.first);
+			}
+
+			m_StopCondition.wait_for(lock, std::chrono::milliseconds(m_PollInterval), [this] { return !m_Running; });
+		}
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+namespace Engine
+{
+	// Watches files for modification from a background thread, which polls their write times.
+	// Changes are collected until the owner takes them, so no callback ever runs on the watcher thread.
+	class FileWatcher
+	{
+	public:
+		FileWatcher(uint32_t pollIntervalMilliseconds = 250);
+		~FileWatcher();
+
+		void Watch(const std::string& path);
+		void Unwatch(const std::string& path);
+
+		// Paths modified since the last call, each listed once
+		std::vector<std::string> TakeChanges();
+	private:
+		void Run();
+
+		std::unordered_map<std::string, std::filesystem::file_time_type> m_Files;
+		std::vector<std::string> m_Changes;
+		uint32_t m_PollInterval;
+
+		bool m_Running = true;
+		std::mutex m_Mutex;
+		std::condition_variable m_StopCondition;
+		std::thread m_Thread;
+	};
+}
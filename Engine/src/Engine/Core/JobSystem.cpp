@@ -0,0 +1,146 @@
+#include "engine_pch.h"
+#include "JobSystem.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace Engine
+{
+	struct JobSystemData
+	{
+		std::vector<std::thread> workers;
+		std::mutex mutex;
+		std::condition_variable wakeCondition;
+		std::condition_variable doneCondition;
+		// Bumped for every job so sleeping workers can tell a new job from a spurious wakeup
+		uint64_t generation = 0;
+		bool running = false;
+
+		JobSystem::RangeFunction function = nullptr;
+		void* context = nullptr;
+		uint32_t count = 0;
+		uint32_t granularity = 1;
+		std::atomic<uint32_t> nextBegin{ 0 };
+		std::atomic<uint32_t> pendingRanges{ 0 };
+		uint32_t activeWorkers = 0;
+	};
+
+	static JobSystemData* s_jobs = nullptr;
+
+	// Takes ranges until the job is exhausted; returns the number of ranges completed
+	static uint32_t RunRanges()
+	{
+		uint32_t completed = 0;
+		while (true)
+		{
+			uint32_t begin = s_jobs->nextBegin.fetch_add(s_jobs->granularity);
+			if (begin >= s_jobs->count)
+				break;
+			uint32_t end = std::min(begin + s_jobs->granularity, s_jobs->count);
+			s_jobs->function(s_jobs->context, begin, end);
+			completed++;
+		}
+		return completed;
+	}
+
+	static void WorkerLoop()
+	{
+		uint64_t seenGeneration = 0;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(s_jobs->mutex);
+				s_jobs->wakeCondition.wait(lock, [&] { return !s_jobs->running || s_jobs->generation != seenGeneration; });
+				if (!s_jobs->running)
+					return;
+				seenGeneration = s_jobs->generation;
+				s_jobs->activeWorkers++;
+			}
+
+			uint32_t completed = RunRanges();
+
+			std::lock_guard<std::mutex> lock(s_jobs->mutex);
+			s_jobs->activeWorkers--;
+			s_jobs->pendingRanges -= completed;
+			s_jobs->doneCondition.notify_one();
+		}
+	}
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		EG_CORE_ASSERT(!s_jobs, "JobSystem already initialized!");
+		s_jobs = new JobSystemData();
+
+		if (workerCount == 0)
+		{
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+		}
+
+		s_jobs->running = true;
+		s_jobs->workers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; i++)
+			s_jobs->workers.emplace_back(WorkerLoop);
+	}
+
+	void JobSystem::ShutDown()
+	{
+		if (!s_jobs)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(s_jobs->mutex);
+			s_jobs->running = false;
+		}
+		s_jobs->wakeCondition.notify_all();
+		for (std::thread& worker : s_jobs->workers)
+			worker.join();
+
+		delete s_jobs;
+		s_jobs = nullptr;
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return s_jobs ? (uint32_t)s_jobs->workers.size() : 0;
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t granularity, RangeFunction function, void* context)
+	{
+		if (count == 0)
+			return;
+		granularity = std::max(granularity, 1u);
+
+		if (!s_jobs || s_jobs->workers.empty() || count <= granularity)
+		{
+			for (uint32_t begin = 0; begin < count; begin += granularity)
+				function(context, begin, std::min(begin + granularity, count));
+			return;
+		}
+
+		uint32_t rangeCount = (count + granularity - 1) / granularity;
+		{
+			// A worker that woke up too late for the previous job may still be leaving it
+			std::unique_lock<std::mutex> lock(s_jobs->mutex);
+			EG_CORE_ASSERT(s_jobs->pendingRanges == 0, "ParallelFor is not reentrant!");
+			s_jobs->doneCondition.wait(lock, [] { return s_jobs->activeWorkers == 0; });
+			s_jobs->function = function;
+			s_jobs->context = context;
+			s_jobs->count = count;
+			s_jobs->granularity = granularity;
+			s_jobs->nextBegin = 0;
+			s_jobs->pendingRanges = rangeCount;
+			s_jobs->generation++;
+		}
+		s_jobs->wakeCondition.notify_all();
+
+		uint32_t completed = RunRanges();
+
+		// Ranges are only counted as done once their worker has returned from them
+		std::unique_lock<std::mutex> lock(s_jobs->mutex);
+		s_jobs->pendingRanges -= completed;
+		s_jobs->doneCondition.wait(lock, [] { return s_jobs->pendingRanges == 0; });
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+namespace Engine
+{
+	// A fixed pool of worker threads for data-parallel loops. Workers are started once and sleep
+	// between jobs; dispatching a job does not allocate.
+	class JobSystem
+	{
+	public:
+		typedef void (*RangeFunction)(void* context, uint32_t begin, uint32_t end);
+
+		// workerCount 0 uses one worker per hardware thread besides the calling one
+		static void Init(uint32_t workerCount = 0);
+		static void ShutDown();
+
+		static uint32_t GetWorkerCount();
+
+		// Calls function on ranges of [0, count) no smaller than granularity, on the workers and the
+		// calling thread, and returns once every range is done. Small counts run inline.
+		// Only one ParallelFor may run at a time and function must not start another one.
+		static void ParallelFor(uint32_t count, uint32_t granularity, RangeFunction function, void* context);
+	};
+}
@@ -0,0 +1,155 @@
+#include "engine_pch.h"
+#include "SIMD.h"
+
+#ifdef _MSC_VER
+	#include <intrin.h>
+#endif
+
+namespace Engine
+{
+	static bool DetectAVX2()
+	{
+#if defined(EG_SIMD_X86) && defined(_MSC_VER)
+		int regs[4];
+		__cpuid(regs, 1);
+		bool osxsave = (regs[2] & BIT(27)) != 0;
+		bool avx = (regs[2] & BIT(28)) != 0;
+		if (!osxsave || !avx)
+			return false;
+
+		// XMM and YMM state must both be enabled by the OS
+		if ((_xgetbv(0) & 0x6) != 0x6)
+			return false;
+
+		__cpuidex(regs, 7, 0);
+		return (regs[1] & BIT(5)) != 0;
+#elif defined(EG_SIMD_X86)
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+#else
+		return false;
+#endif
+	}
+
+	bool SIMD::HasAVX2()
+	{
+		static const bool s_HasAVX2 = DetectAVX2();
+		return s_HasAVX2;
+	}
+
+	void* SIMD::AlignedAlloc(size_t size, size_t alignment)
+	{
+#ifdef EG_SIMD_X86
+		return _mm_malloc(size, alignment);
+#else
+		return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+	}
+
+	void SIMD::AlignedFree(void* ptr)
+	{
+#ifdef EG_SIMD_X86
+		_mm_free(ptr);
+#else
+		std::free(ptr);
+#endif
+	}
+
+	// Bit twiddling after F. Giesen's float_to_half_fast3_rtne: the subnormal range is rounded by the FPU
+	// through a magic addition, normal values by adding half an ulp minus one plus the odd bit.
+	static const uint32_t HalfMaxBits = (127 + 16) << 23;
+	static const uint32_t HalfMinNormalBits = (127 - 14) << 23;
+	static const uint32_t HalfSubnormalMagicBits = ((127 - 15) + (23 - 10) + 1) << 23;
+	static const uint32_t HalfNormalBias = 0xfff - ((127 - 15) << 23);
+
+	uint16_t SIMD::FloatToHalf(float value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		uint32_t sign = bits & 0x80000000u;
+		bits ^= sign;
+
+		uint32_t half;
+		if (bits >= HalfMaxBits)
+			half = bits > 0x7f800000u ? 0x7e00 : 0x7c00;
+		else if (bits < HalfMinNormalBits)
+		{
+			float magic;
+			memcpy(&magic, &HalfSubnormalMagicBits, sizeof(magic));
+			float absValue;
+			memcpy(&absValue, &bits, sizeof(absValue));
+			absValue += magic;
+			memcpy(&half, &absValue, sizeof(half));
+			half -= HalfSubnormalMagicBits;
+		}
+		else
+		{
+			uint32_t mantissaOdd = (bits >> 13) & 1;
+			half = (bits + HalfNormalBias + mantissaOdd) >> 13;
+		}
+		return (uint16_t)(half | (sign >> 16));
+	}
+
+	void SIMD::FloatToHalf(const float* src, uint16_t* dst, size_t count)
+	{
+		size_t i = 0;
+#ifdef EG_SIMD_X86
+		const __m128i maxBits = _mm_set1_epi32(HalfMaxBits);
+		const __m128i minNormalBits = _mm_set1_epi32(HalfMinNormalBits);
+		const __m128i subnormalMagic = _mm_set1_epi32(HalfSubnormalMagicBits);
+		const __m128i normalBias = _mm_set1_epi32(HalfNormalBias);
+		const __m128i infinity = _mm_set1_epi32(0x7c00);
+		const __m128i quietBit = _mm_set1_epi32(0x200);
+		const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 value = _mm_loadu_ps(src + i);
+			__m128 sign = _mm_and_ps(value, signMask);
+			__m128 absValue = _mm_xor_ps(value, sign);
+			__m128i bits = _mm_castps_si128(absValue);
+
+			__m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(absValue, absValue));
+			__m128i isFinite = _mm_cmpgt_epi32(maxBits, bits);
+			__m128i isSubnormal = _mm_cmpgt_epi32(minNormalBits, bits);
+			__m128i special = _mm_or_si128(_mm_and_si128(isNaN, quietBit), infinity);
+
+			__m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absValue, _mm_castsi128_ps(subnormalMagic))), subnormalMagic);
+			// Subtracting the all-ones mask of odd mantissas adds the round-to-even bit
+			__m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(bits, 31 - 13), 31);
+			__m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(bits, normalBias), mantissaOdd), 13);
+
+			__m128i finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+			__m128i half = _mm_or_si128(_mm_and_si128(isFinite, finite), _mm_andnot_si128(isFinite, special));
+			// The arithmetic shift sign-extends, so the signed saturating pack keeps the 16 bits as they are
+			half = _mm_or_si128(half, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+			_mm_storel_epi64((__m128i*)(dst + i), _mm_packs_epi32(half, half));
+		}
+#endif
+		for (; i < count; i++)
+			dst[i] = FloatToHalf(src[i]);
+	}
+
+	void SIMD::FloatToRGBA8(const float* src, uint32_t* dst, size_t count)
+	{
+		size_t i = 0;
+#ifdef EG_SIMD_X86
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 scale = _mm_set1_ps(255.f);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i channels[4];
+			for (int c = 0; c < 4; c++)
+			{
+				__m128 color = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + (i + c) * 4), zero), one);
+				channels[c] = _mm_cvtps_epi32(_mm_mul_ps(color, scale));
+			}
+			__m128i packed = _mm_packus_epi16(_mm_packs_epi32(channels[0], channels[1]), _mm_packs_epi32(channels[2], channels[3]));
+			_mm_storeu_si128((__m128i*)(dst + i), packed);
+		}
+#endif
+		for (; i < count; i++)
+			dst[i] = FloatToRGBA8(src + i * 4);
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+	#define EG_SIMD_X86
+	#include <immintrin.h>
+#endif
+
+// Functions using AVX2 intrinsics are compiled for AVX2 individually and only called after HasAVX2()
+#if defined(_MSC_VER)
+	#define EG_TARGET_AVX2
+#else
+	#define EG_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+namespace Engine
+{
+	class SIMD
+	{
+	public:
+		// Checked once on first use, including OS support for saving the YMM registers
+		static bool HasAVX2();
+
+		static void* AlignedAlloc(size_t size, size_t alignment = 32);
+		static void AlignedFree(void* ptr);
+
+		// Packing for compact vertex formats (ShaderDataType::Half2/Half4 and UByte4Norm).
+		// Halves round to nearest even, values beyond the half range become infinity.
+		static uint16_t FloatToHalf(float value);
+		static void FloatToHalf(const float* src, uint16_t* dst, size_t count);
+
+		// An RGBA color of 4 floats to 8 bits per channel, R in the lowest byte; channels are clamped to [0, 1]
+		static inline uint32_t FloatToRGBA8(const float* rgba)
+		{
+#ifdef EG_SIMD_X86
+			__m128 color = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(rgba), _mm_setzero_ps()), _mm_set1_ps(1.f));
+			__m128i channels = _mm_cvtps_epi32(_mm_mul_ps(color, _mm_set1_ps(255.f)));
+			channels = _mm_packs_epi32(channels, channels);
+			channels = _mm_packus_epi16(channels, channels);
+			return (uint32_t)_mm_cvtsi128_si32(channels);
+#else
+			uint32_t packed = 0;
+			for (int i = 0; i < 4; i++)
+			{
+				float channel = std::min(std::max(rgba[i], 0.f), 1.f);
+				packed |= (uint32_t)(channel * 255.f + .5f) << (i * 8);
+			}
+			return packed;
+#endif
+		}
+		// count colors, 4 floats each
+		static void FloatToRGBA8(const float* src, uint32_t* dst, size_t count);
+	};
+}
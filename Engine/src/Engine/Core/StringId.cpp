@@ -0,0 +1,48 @@
+#include "engine_pch.h"
+#include "StringId.h"
+
+#include <mutex>
+
+namespace Engine
+{
+#ifdef ENGINE_DEBUG
+	struct StringIdTable
+	{
+		// IDs are made on loading threads as well
+		std::mutex mutex;
+		std::unordered_map<uint64_t, std::string> texts;
+	};
+
+	static StringIdTable& GetTable()
+	{
+		// Constructed on first use, IDs of static objects can be made before main
+		static StringIdTable table;
+		return table;
+	}
+#endif
+
+	StringId::StringId(const std::string& text)
+		: m_Hash(Hash(text.data(), text.size()))
+	{
+#ifdef ENGINE_DEBUG
+		StringIdTable& table = GetTable();
+		std::lock_guard<std::mutex> lock(table.mutex);
+		auto result = table.texts.emplace(m_Hash, text);
+		EG_CORE_ASSERT(result.second || result.first->second == text, "StringId collision!");
+#endif
+	}
+
+	std::string StringId::ToString() const
+	{
+#ifdef ENGINE_DEBUG
+		StringIdTable& table = GetTable();
+		std::lock_guard<std::mutex> lock(table.mutex);
+		auto it = table.texts.find(m_Hash);
+		if (it != table.texts.end())
+			return it->second;
+#endif
+		char text[24];
+		snprintf(text, sizeof(text), "#%016llx", (unsigned long long)m_Hash);
+		return text;
+	}
+}
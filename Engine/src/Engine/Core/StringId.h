@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+
+namespace Engine
+{
+	// A 64-bit FNV-1a hash standing in for a string in lookups. IDs of string literals are computed by the
+	// compiler when used as constants, e.g. static constexpr StringId Name = "u_Name"_sid;, so looking them up
+	// builds and hashes nothing at run time. Debug builds keep the text of every ID made from a run-time
+	// string, which is how table keys are made, so ToString can print them and collisions are caught.
+	class StringId
+	{
+	public:
+		constexpr StringId()
+			: m_Hash(0)
+		{
+		}
+
+		constexpr StringId(const char* text)
+			: m_Hash(Hash(text, Length(text)))
+		{
+		}
+
+		// Hashes at run time and, in debug builds, records the text under a lock; for loading code, not per frame
+		explicit StringId(const std::string& text);
+
+		static constexpr uint64_t Hash(const char* text, size_t length)
+		{
+			uint64_t hash = 0xcbf29ce484222325ull;
+			for (size_t i = 0; i < length; i++)
+			{
+				hash ^= (uint8_t)text[i];
+				hash *= 0x100000001b3ull;
+			}
+			return hash;
+		}
+
+		static constexpr StringId FromHash(uint64_t hash)
+		{
+			StringId id;
+			id.m_Hash = hash;
+			return id;
+		}
+
+		constexpr uint64_t GetHash() const { return m_Hash; }
+
+		// The text in debug builds when it is known, the hash otherwise
+		std::string ToString() const;
+
+		constexpr bool operator==(const StringId& other) const { return m_Hash == other.m_Hash; }
+		constexpr bool operator!=(const StringId& other) const { return m_Hash != other.m_Hash; }
+		constexpr bool operator<(const StringId& other) const { return m_Hash < other.m_Hash; }
+	private:
+		static constexpr size_t Length(const char* text)
+		{
+			size_t length = 0;
+			while (text[length])
+				length++;
+			return length;
+		}
+
+		uint64_t m_Hash;
+	};
+
+	constexpr StringId operator""_sid(const char* text, size_t length)
+	{
+		return StringId::FromHash(StringId::Hash(text, length));
+	}
+}
+
+namespace std
+{
+	// The hash is already well distributed
+	template<>
+	struct hash<Engine::StringId>
+	{
+		size_t operator()(const Engine::StringId& id) const { return (size_t)id.GetHash(); }
+	};
+}
@@ -6,6 +6,7 @@
 #include "backends/imgui_impl_opengl3.h"
 
 #include "Engine/Application.h"
+#include "Platform/OpenGL/OpenGLStateCache.h"
 
 // TEMPORARY
 #include <glad/glad.h>
@@ -94,5 +95,8 @@ namespace Engine
 			ImGui::RenderPlatformWindowsDefault();
 			glfwMakeContextCurrent(window);
 		}
+
+		// The ImGui backend sets GL state directly
+		OpenGLStateCache::Invalidate();
 	}
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
 namespace Engine
 {
 	Layer::Layer(const std::string& name)
-		:m_DebugName(name)
+		:m_DebugName(name), m_NameId(name)
 	{
 	}
 
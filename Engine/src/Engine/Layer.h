@@ -1,5 +1,6 @@
 #pragma once
 #include <Engine/Core/Timestep.h>
+#include <Engine/Core/StringId.h>
 
 namespace Engine
 {
@@ -18,8 +19,10 @@ namespace Engine
 		virtual void OnEvent(Event& evnt) {}
 		
 		const std::string& GetName() const { return m_DebugName; }
+		StringId GetNameId() const { return m_NameId; }
 
 	protected:
 		std::string m_DebugName;
+		StringId m_NameId;
 	};
 }
@@ -42,4 +42,14 @@ namespace Engine
 		if (it != m_Layers.end())
 			m_Layers.erase(it);
 	}
+
+	Layer* LayerStack::Find(StringId name) const
+	{
+		for (Layer* layer : m_Layers)
+		{
+			if (layer->GetNameId() == name)
+				return layer;
+		}
+		return nullptr;
+	}
 }
\ No newline at end of file
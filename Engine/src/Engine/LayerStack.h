@@ -14,6 +14,9 @@ namespace Engine
 		void PopLayer(Layer* layer);
 		void PopOverlay(Layer* overlay);
 
+		// First layer or overlay with the name, nullptr if there is none
+		Layer* Find(StringId name) const;
+
 		std::vector<Layer*>::iterator begin() { return m_Layers.begin(); }
 		std::vector<Layer*>::iterator end() { return m_Layers.end(); }
 	private:
@@ -6,8 +6,26 @@
 
 namespace Engine
 {
+	VertexBuffer* VertexBuffer::Create(uint32_t size)
+	{
+		RenderCommand::RequireContext("VertexBuffer");
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			EG_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+			return nullptr;
+			break;
+		case RendererAPI::API::OpenGL:
+			return new OpenGLVertexBuffer(size);
+			break;
+		}
+		EG_CORE_ASSERT(false, "RendererAPI case is currently not supported!");
+		return nullptr;
+	}
+
 	VertexBuffer* VertexBuffer::Create(float* vertices, uint32_t size)
 	{
+		RenderCommand::RequireContext("VertexBuffer");
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::None:
@@ -21,8 +39,60 @@ namespace Engine
 		EG_CORE_ASSERT(false, "RendererAPI case is currently not supported!");
 		return nullptr;
 	}
+	ShaderStorageBuffer* ShaderStorageBuffer::Create(uint32_t size, const void* data)
+	{
+		RenderCommand::RequireContext("ShaderStorageBuffer");
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			EG_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+			return nullptr;
+			break;
+		case RendererAPI::API::OpenGL:
+			return new OpenGLShaderStorageBuffer(size, data);
+			break;
+		}
+		EG_CORE_ASSERT(false, "RendererAPI case is currently not supported!");
+		return nullptr;
+	}
+
+	UniformBuffer* UniformBuffer::Create(uint32_t size, const void* data)
+	{
+		RenderCommand::RequireContext("UniformBuffer");
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			EG_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+			return nullptr;
+			break;
+		case RendererAPI::API::OpenGL:
+			return new OpenGLUniformBuffer(size, data);
+			break;
+		}
+		EG_CORE_ASSERT(false, "RendererAPI case is currently not supported!");
+		return nullptr;
+	}
+
+	IndirectBuffer* IndirectBuffer::Create(uint32_t size, const void* data)
+	{
+		RenderCommand::RequireContext("IndirectBuffer");
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			EG_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+			return nullptr;
+			break;
+		case RendererAPI::API::OpenGL:
+			return new OpenGLIndirectBuffer(size, data);
+			break;
+		}
+		EG_CORE_ASSERT(false, "RendererAPI case is currently not supported!");
+		return nullptr;
+	}
+
 	IndexBuffer* IndexBuffer::Create(uint32_t* indices, uint32_t count)
 	{
+		RenderCommand::RequireContext("IndexBuffer");
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::None:
@@ -30,10 +100,68 @@ namespace Engine
 			return nullptr;
 			break;
 		case RendererAPI::API::OpenGL:
-			return new OpenGLIndexBuffer(indices, count);
+			return new OpenGLIndexBuffer(indices, count, IndexType::UInt32);
 			break;
 		}
 		EG_CORE_ASSERT(false, "RendererAPI case is currently not supported!");
 		return nullptr;
 	}
+
+	IndexBuffer* IndexBuffer::Create(uint16_t* indices, uint32_t count)
+	{
+		RenderCommand::RequireContext("IndexBuffer");
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			EG_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+			return nullptr;
+			break;
+		case RendererAPI::API::OpenGL:
+			return new OpenGLIndexBuffer(indices, count, IndexType::UInt16);
+			break;
+		}
+		EG_CORE_ASSERT(false, "RendererAPI case is currently not supported!");
+		return nullptr;
+	}
+
+	template<typename T>
+	static IndexBuffer* CreateQuadIndices(uint32_t quadCount)
+	{
+		std::vector<T> indices((size_t)quadCount * 6);
+		for (uint32_t quad = 0; quad < quadCount; quad++)
+		{
+			T offset = (T)(quad * 4);
+			T* index = &indices[(size_t)quad * 6];
+			index[0] = offset + 0;
+			index[1] = offset + 1;
+			index[2] = offset + 2;
+
+			index[3] = offset + 2;
+			index[4] = offset + 3;
+			index[5] = offset + 0;
+		}
+		return IndexBuffer::Create(indices.data(), (uint32_t)indices.size());
+	}
+
+	Ref<IndexBuffer> IndexBuffer::GetQuadIndexBuffer(uint32_t quadCount)
+	{
+		// Weak, so the buffers go away with their last user rather than after the context at exit
+		static std::weak_ptr<IndexBuffer> s_QuadIndexBuffers[2];
+		static uint32_t s_QuadIndexBufferQuads[2] = { 0, 0 };
+
+		const uint32_t maxQuads16 = 65536 / 4;
+		uint32_t type = quadCount <= maxQuads16 ? 0 : 1;
+
+		Ref<IndexBuffer> indexBuffer = s_QuadIndexBuffers[type].lock();
+		if (indexBuffer && s_QuadIndexBufferQuads[type] >= quadCount)
+			return indexBuffer;
+
+		if (type == 0)
+			indexBuffer.reset(CreateQuadIndices<uint16_t>(quadCount));
+		else
+			indexBuffer.reset(CreateQuadIndices<uint32_t>(quadCount));
+		s_QuadIndexBuffers[type] = indexBuffer;
+		s_QuadIndexBufferQuads[type] = quadCount;
+		return indexBuffer;
+	}
 }
\ No newline at end of file
@@ -5,7 +5,9 @@ namespace Engine
 	enum class ShaderDataType : uint8_t
 	{
 		None = 0,
-		Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool
+		Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool,
+		// Compact types; the normalized ones read as floats in [0, 1] or [-1, 1], RGB10A2 as an unsigned normalized vec4
+		Half2, Half4, UByte4Norm, Short2Norm, UInt, RGB10A2
 	};
 
 	static uint32_t ShaderDataTypeSize(ShaderDataType type)
@@ -34,6 +36,18 @@ namespace Engine
 			return sizeof(int) * 4;
 		case Engine::ShaderDataType::Bool:
 			return sizeof(bool);
+		case Engine::ShaderDataType::Half2:
+			return sizeof(uint16_t) * 2;
+		case Engine::ShaderDataType::Half4:
+			return sizeof(uint16_t) * 4;
+		case Engine::ShaderDataType::UByte4Norm:
+			return sizeof(uint8_t) * 4;
+		case Engine::ShaderDataType::Short2Norm:
+			return sizeof(int16_t) * 2;
+		case Engine::ShaderDataType::UInt:
+			return sizeof(uint32_t);
+		case Engine::ShaderDataType::RGB10A2:
+			return sizeof(uint32_t);
 		}
 		EG_CORE_ASSERT(false, "Unknown ShaderDataType!");
 		return 0;
@@ -46,11 +60,13 @@ namespace Engine
 		uint32_t Size;
 		uint32_t Offset;
 		bool Normalized;
+		// 0 advances the attribute per vertex, n advances it once every n instances
+		uint32_t Divisor;
 
 		BufferElement() {}
 
-		BufferElement(ShaderDataType type, const std::string& name, bool normalize = false)
-			:Name(name), Type(type), Size(ShaderDataTypeSize(type)), Offset(0), Normalized(normalize)
+		BufferElement(ShaderDataType type, const std::string& name, bool normalize = false, uint32_t divisor = 0)
+			:Name(name), Type(type), Size(ShaderDataTypeSize(type)), Offset(0), Normalized(normalize || IsNormalizedType(type)), Divisor(divisor)
 		{
 		}
 		uint32_t GetComponentCount() const
@@ -79,7 +95,55 @@ namespace Engine
 				return 4;
 			case Engine::ShaderDataType::Bool:
 				return 1;
+			case Engine::ShaderDataType::Half2:
+				return 2;
+			case Engine::ShaderDataType::Half4:
+				return 4;
+			case Engine::ShaderDataType::UByte4Norm:
+				return 4;
+			case Engine::ShaderDataType::Short2Norm:
+				return 2;
+			case Engine::ShaderDataType::UInt:
+				return 1;
+			case Engine::ShaderDataType::RGB10A2:
+				return 4;
+			}
+			EG_CORE_ASSERT(false, "Unknown ShaderDataType!");
+			return 0;
+		}
+
+		// Matrices occupy one attribute location per column
+		uint32_t GetLocationCount() const
+		{
+			switch (Type)
+			{
+			case Engine::ShaderDataType::Mat3:
+				return 3;
+			case Engine::ShaderDataType::Mat4:
+				return 4;
+			}
+			return 1;
+		}
+
+		bool IsPerInstance() const { return Divisor != 0; }
+		// Integer attributes reach the shader as int/uint instead of being converted to float
+		bool IsInteger() const
+		{
+			switch (Type)
+			{
+			case Engine::ShaderDataType::Int:
+			case Engine::ShaderDataType::Int2:
+			case Engine::ShaderDataType::Int3:
+			case Engine::ShaderDataType::Int4:
+			case Engine::ShaderDataType::UInt:
+				return true;
 			}
+			return false;
+		}
+
+		static bool IsNormalizedType(ShaderDataType type)
+		{
+			return type == ShaderDataType::UByte4Norm || type == ShaderDataType::Short2Norm || type == ShaderDataType::RGB10A2;
 		}
 	};
 
@@ -125,12 +189,25 @@ namespace Engine
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 
+		virtual void SetData(const void* data, uint32_t size) = 0;
+
 		virtual void SetLayout(const BufferLayout& layout) = 0;
 		virtual const BufferLayout& GetLayout() const = 0;
 
+		static VertexBuffer* Create(uint32_t size);
 		static VertexBuffer* Create(float* vertices, uint32_t size);
 	};
 
+	enum class IndexType : uint8_t
+	{
+		UInt16 = 0, UInt32
+	};
+
+	static uint32_t IndexTypeSize(IndexType type)
+	{
+		return type == IndexType::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t);
+	}
+
 	class IndexBuffer
 	{
 	public:
@@ -140,7 +217,84 @@ namespace Engine
 		virtual void Unbind() const = 0;
 
 		virtual uint32_t GetCount() const = 0;
+		// Draw calls read the indices with this type
+		virtual IndexType GetIndexType() const = 0;
 
 		static IndexBuffer* Create(uint32_t* indices, uint32_t count);
+		// Half the size; enough for anything drawn from at most 65536 vertices past the base vertex
+		static IndexBuffer* Create(uint16_t* indices, uint32_t count);
+
+		// Shared buffer holding the 0, 1, 2, 2, 3, 0 quad pattern for at least quadCount quads. It is 16-bit
+		// as long as the quads fit in 65536 vertices, and grows by replacing the shared buffer, so holders
+		// of a smaller one keep theirs.
+		static Ref<IndexBuffer> GetQuadIndexBuffer(uint32_t quadCount);
+	};
+
+	// A buffer read and written by shaders through a std430 storage block
+	class ShaderStorageBuffer
+	{
+	public:
+		virtual ~ShaderStorageBuffer() {}
+
+		// Attaches the buffer to the storage block declared with layout(binding = binding)
+		virtual void BindBase(uint32_t binding) const = 0;
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+		// Zeroes a range on the GPU without uploading anything; offset and size must be multiples of 4
+		virtual void ClearData(uint32_t offset, uint32_t size) = 0;
+		// Copies a range back to the CPU, waiting for every command writing it to finish; not for per-frame use
+		virtual void GetData(void* data, uint32_t size, uint32_t offset = 0) const = 0;
+
+		virtual uint32_t GetSize() const = 0;
+
+		static ShaderStorageBuffer* Create(uint32_t size, const void* data = nullptr);
+	};
+
+	// Backs a std140 uniform block; the C++ struct mirroring the block must follow std140 alignment
+	class UniformBuffer
+	{
+	public:
+		virtual ~UniformBuffer() {}
+
+		// Attaches the buffer to the uniform block bound to binding
+		virtual void BindBase(uint32_t binding) const = 0;
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+
+		virtual uint32_t GetSize() const = 0;
+
+		static UniformBuffer* Create(uint32_t size, const void* data = nullptr);
+	};
+
+	// Layout of one command in an IndirectBuffer used with DrawArraysIndirect
+	struct DrawArraysIndirectCommand
+	{
+		uint32_t Count;
+		uint32_t InstanceCount;
+		uint32_t First;
+		uint32_t BaseInstance;
+	};
+
+	// Layout of one command in an IndirectBuffer used with MultiDrawIndexedIndirect
+	struct DrawElementsIndirectCommand
+	{
+		uint32_t Count;
+		uint32_t InstanceCount;
+		uint32_t FirstIndex;
+		int32_t BaseVertex;
+		uint32_t BaseInstance;
+	};
+
+	// Holds draw parameters written by shaders, so draws can be sized without reading anything back.
+	// It can also be bound as a storage buffer for the shaders that fill it in.
+	class IndirectBuffer : public ShaderStorageBuffer
+	{
+	public:
+		virtual ~IndirectBuffer() {}
+
+		virtual void Bind() const = 0;
+		virtual void Unbind() const = 0;
+
+		static IndirectBuffer* Create(uint32_t size, const void* data = nullptr);
 	};
 }
@@ -0,0 +1,319 @@
+#include "engine_pch.h"
+#include "Font.h"
+
+#include <stb_image.h>
+#include <cfloat>
+
+namespace Engine
+{
+	// Layouts are dropped wholesale once this many different strings have been drawn
+	static const size_t MaxCachedRuns = 4096;
+	// Squared distance of pixels without a seed; finite so the parabola intersections stay defined
+	static const float DistanceInfinity = 1e20f;
+
+	// Returns the value of key=value in a BMFont line, without quotes
+	static std::string FindAttribute(const std::string& line, const char* key)
+	{
+		std::string pattern = std::string(" ") + key + "=";
+		size_t start = line.find(pattern);
+		if (start == std::string::npos)
+			return std::string();
+
+		start += pattern.size();
+		if (start < line.size() && line[start] == '"')
+		{
+			size_t end = line.find('"', start + 1);
+			return line.substr(start + 1, end == std::string::npos ? std::string::npos : end - start - 1);
+		}
+		size_t end = line.find_first_of(" \t\r", start);
+		return line.substr(start, end == std::string::npos ? std::string::npos : end - start);
+	}
+
+	static float FindFloat(const std::string& line, const char* key)
+	{
+		std::string value = FindAttribute(line, key);
+		return value.empty() ? 0.f : (float)atof(value.c_str());
+	}
+
+	static uint32_t DecodeUTF8(const std::string& text, size_t& i)
+	{
+		uint8_t c = (uint8_t)text[i++];
+		if (c < 0x80)
+			return c;
+
+		uint32_t length = c >= 0xf0 ? 3 : c >= 0xe0 ? 2 : c >= 0xc0 ? 1 : 0;
+		uint32_t codepoint = c & (0x3f >> length);
+		for (uint32_t j = 0; j < length && i < text.size(); j++)
+			codepoint = (codepoint << 6) | ((uint8_t)text[i++] & 0x3f);
+		return codepoint;
+	}
+
+	// Exact squared Euclidean distance transform of one row or column (Felzenszwalb & Huttenlocher)
+	static void DistanceTransform1D(const float* f, float* d, int32_t n, int32_t* v, float* z)
+	{
+		int32_t k = 0;
+		v[0] = 0;
+		z[0] = -FLT_MAX;
+		z[1] = FLT_MAX;
+		for (int32_t q = 1; q < n; q++)
+		{
+			float s;
+			while (true)
+			{
+				s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.f * q - 2.f * v[k]);
+				if (s > z[k] || k == 0)
+					break;
+				k--;
+			}
+			k++;
+			v[k] = q;
+			z[k] = s;
+			z[k + 1] = FLT_MAX;
+		}
+
+		k = 0;
+		for (int32_t q = 0; q < n; q++)
+		{
+			while (z[k + 1] < q)
+				k++;
+			float delta = (float)(q - v[k]);
+			d[q] = delta * delta + f[v[k]];
+		}
+	}
+
+	// Squared distance of every pixel to the nearest seed pixel
+	static void DistanceTransform2D(std::vector<float>& grid, int32_t width, int32_t height)
+	{
+		int32_t n = std::max(width, height);
+		std::vector<float> f(n), d(n), z(n + 1);
+		std::vector<int32_t> v(n);
+
+		for (int32_t x = 0; x < width; x++)
+		{
+			for (int32_t y = 0; y < height; y++)
+				f[y] = grid[(size_t)y * width + x];
+			DistanceTransform1D(f.data(), d.data(), height, v.data(), z.data());
+			for (int32_t y = 0; y < height; y++)
+				grid[(size_t)y * width + x] = d[y];
+		}
+		for (int32_t y = 0; y < height; y++)
+		{
+			float* row = &grid[(size_t)y * width];
+			memcpy(f.data(), row, width * sizeof(float));
+			DistanceTransform1D(f.data(), row, width, v.data(), z.data());
+		}
+	}
+
+	Font::Font(const std::string& path, AtlasType atlasType, float distanceRange)
+	{
+		m_AsciiGlyphs.fill(-1);
+
+		std::string pagePath;
+		if (!LoadDescription(path, pagePath))
+			return;
+
+		// The page is named relative to the .fnt file
+		size_t lastSlash = path.find_last_of("/\\");
+		if (lastSlash != std::string::npos)
+			pagePath = path.substr(0, lastSlash + 1) + pagePath;
+		LoadAtlas(pagePath, atlasType, distanceRange);
+	}
+
+	Ref<Font> Font::Create(const std::string& path, AtlasType atlasType, float distanceRange)
+	{
+		return std::make_shared<Font>(path, atlasType, distanceRange);
+	}
+
+	bool Font::LoadDescription(const std::string& path, std::string& pagePath)
+	{
+		std::ifstream file(path);
+		if (!file)
+		{
+			EG_CORE_ERROR("Could not open font '{0}'", path);
+			return false;
+		}
+
+		std::string line;
+		while (std::getline(file, line))
+		{
+			std::string tag = line.substr(0, line.find(' '));
+			line.insert(line.begin(), ' ');
+			if (tag == "info")
+			{
+				m_Name = FindAttribute(line, "face");
+			}
+			else if (tag == "common")
+			{
+				m_LineHeight = std::max(FindFloat(line, "lineHeight"), 1.f);
+				m_Base = FindFloat(line, "base");
+				m_AtlasSize = { std::max(FindFloat(line, "scaleW"), 1.f), std::max(FindFloat(line, "scaleH"), 1.f) };
+				if (FindFloat(line, "pages") > 1.f)
+					EG_CORE_WARN("Font '{0}' has several pages, only the first one is used", path);
+			}
+			else if (tag == "page")
+			{
+				if (FindFloat(line, "id") == 0.f)
+					pagePath = FindAttribute(line, "file");
+			}
+			else if (tag == "char")
+			{
+				if (FindFloat(line, "page") != 0.f)
+					continue;
+
+				glm::vec2 position = { FindFloat(line, "x"), FindFloat(line, "y") };
+				glm::vec2 size = { FindFloat(line, "width"), FindFloat(line, "height") };
+				glm::vec2 offset = { FindFloat(line, "xoffset"), FindFloat(line, "yoffset") };
+
+				// Pixels measured down from the top of the line become line heights up from the baseline
+				Glyph glyph;
+				glyph.Size = { size.x / m_LineHeight, size.y / m_LineHeight };
+				glyph.Offset = { offset.x / m_LineHeight, (m_Base - offset.y - size.y) / m_LineHeight };
+				glyph.Advance = FindFloat(line, "xadvance") / m_LineHeight;
+
+				// Textures are loaded flipped, so image rows count down from v = 1
+				glyph.TexCoordMin = { position.x / m_AtlasSize.x, 1.f - (position.y + size.y) / m_AtlasSize.y };
+				glyph.TexCoordMax = { (position.x + size.x) / m_AtlasSize.x, 1.f - position.y / m_AtlasSize.y };
+
+				uint32_t codepoint = (uint32_t)FindFloat(line, "id");
+				uint32_t index = (uint32_t)m_Glyphs.size();
+				m_Glyphs.push_back(glyph);
+				if (codepoint < m_AsciiGlyphs.size())
+					m_AsciiGlyphs[codepoint] = (int32_t)index;
+				else
+					m_GlyphIndices[codepoint] = index;
+			}
+			else if (tag == "kerning")
+			{
+				uint64_t first = (uint64_t)FindFloat(line, "first");
+				uint64_t second = (uint64_t)FindFloat(line, "second");
+				m_Kerning[(first << 32) | second] = FindFloat(line, "amount") / m_LineHeight;
+			}
+		}
+
+		if (pagePath.empty() || m_Glyphs.empty())
+		{
+			EG_CORE_ERROR("Font '{0}' is not a BMFont text file", path);
+			return false;
+		}
+		return true;
+	}
+
+	bool Font::LoadAtlas(const std::string& pagePath, AtlasType atlasType, float distanceRange)
+	{
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load(1);
+		stbi_uc* data = stbi_load(pagePath.c_str(), &width, &height, &channels, 4);
+		if (!data)
+		{
+			EG_CORE_ERROR("Could not load font atlas '{0}'", pagePath);
+			return false;
+		}
+
+		// Single channel images carry the glyphs in red, the others in alpha
+		size_t pixelCount = (size_t)width * height;
+		uint32_t channel = (channels == 1 || channels == 3) ? 0 : 3;
+		std::vector<uint8_t> alpha(pixelCount);
+		for (size_t i = 0; i < pixelCount; i++)
+			alpha[i] = data[i * 4 + channel];
+		stbi_image_free(data);
+
+		if (atlasType == AtlasType::Coverage)
+		{
+			// Distance from outside pixels to the glyphs and from inside pixels to the background
+			std::vector<float> outside(pixelCount), inside(pixelCount);
+			for (size_t i = 0; i < pixelCount; i++)
+			{
+				bool isInside = alpha[i] > 127;
+				outside[i] = isInside ? 0.f : DistanceInfinity;
+				inside[i] = isInside ? DistanceInfinity : 0.f;
+			}
+			DistanceTransform2D(outside, width, height);
+			DistanceTransform2D(inside, width, height);
+
+			for (size_t i = 0; i < pixelCount; i++)
+			{
+				float distance = sqrtf(outside[i]) - sqrtf(inside[i]);
+				float value = std::min(std::max(.5f - distance / (2.f * distanceRange), 0.f), 1.f);
+				alpha[i] = (uint8_t)(value * 255.f + .5f);
+			}
+		}
+
+		std::vector<uint32_t> pixels(pixelCount);
+		for (size_t i = 0; i < pixelCount; i++)
+			pixels[i] = 0x00ffffff | ((uint32_t)alpha[i] << 24);
+
+		m_AtlasTexture = Texture2D::Create(width, height, TextureFilter::Linear);
+		m_AtlasTexture->SetData(pixels.data(), (uint32_t)(pixelCount * sizeof(uint32_t)));
+		return true;
+	}
+
+	const Font::Glyph* Font::FindGlyph(uint32_t codepoint) const
+	{
+		if (codepoint < m_AsciiGlyphs.size())
+			return m_AsciiGlyphs[codepoint] >= 0 ? &m_Glyphs[m_AsciiGlyphs[codepoint]] : nullptr;
+
+		auto it = m_GlyphIndices.find(codepoint);
+		return it != m_GlyphIndices.end() ? &m_Glyphs[it->second] : nullptr;
+	}
+
+	float Font::GetKerning(uint32_t first, uint32_t second) const
+	{
+		if (m_Kerning.empty())
+			return 0.f;
+		auto it = m_Kerning.find(((uint64_t)first << 32) | second);
+		return it != m_Kerning.end() ? it->second : 0.f;
+	}
+
+	const Font::GlyphRun& Font::GetGlyphRun(const std::string& text)
+	{
+		auto it = m_RunCache.find(text);
+		if (it != m_RunCache.end())
+			return it->second;
+
+		if (m_RunCache.size() >= MaxCachedRuns)
+			m_RunCache.clear();
+
+		GlyphRun& run = m_RunCache[text];
+		run.Quads.reserve(text.size());
+
+		float pen = 0.f;
+		float baseline = 0.f;
+		uint32_t previous = 0;
+		for (size_t i = 0; i < text.size();)
+		{
+			uint32_t codepoint = DecodeUTF8(text, i);
+			if (codepoint == '\n')
+			{
+				run.Width = std::max(run.Width, pen);
+				run.LineCount++;
+				pen = 0.f;
+				baseline -= 1.f;
+				previous = 0;
+				continue;
+			}
+
+			const Glyph* glyph = FindGlyph(codepoint);
+			if (!glyph)
+				glyph = FindGlyph('?');
+			if (!glyph)
+				continue;
+
+			if (previous)
+				pen += GetKerning(previous, codepoint);
+
+			if (glyph->Size.x > 0.f && glyph->Size.y > 0.f)
+			{
+				GlyphQuad quad;
+				quad.Min = { pen + glyph->Offset.x, baseline + glyph->Offset.y };
+				quad.Max = { quad.Min.x + glyph->Size.x, quad.Min.y + glyph->Size.y };
+				quad.TexCoordMin = glyph->TexCoordMin;
+				quad.TexCoordMax = glyph->TexCoordMax;
+				run.Quads.push_back(quad);
+			}
+			pen += glyph->Advance;
+			previous = codepoint;
+		}
+		run.Width = std::max(run.Width, pen);
+		return run;
+	}
+}
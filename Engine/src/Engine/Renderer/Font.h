@@ -0,0 +1,75 @@
+#pragma once
+#include "Texture.h"
+#include <glm/glm.hpp>
+
+namespace Engine
+{
+	// A single-page font in the BMFont text format (.fnt), drawn with Renderer2D::DrawString.
+	//
+	// The atlas is used as a signed distance field: glyph edges sit at alpha 0.5 and stay sharp at any
+	// scale. Atlases exported as distance fields are used as they are; plain coverage atlases are
+	// converted when the font is loaded, which needs at least distanceRange pixels of glyph padding.
+	class Font
+	{
+	public:
+		enum class AtlasType
+		{
+			DistanceField = 0, Coverage
+		};
+
+		// A positioned glyph; positions are in line heights relative to the run origin on the baseline
+		struct GlyphQuad
+		{
+			glm::vec2 Min;
+			glm::vec2 Max;
+			glm::vec2 TexCoordMin;
+			glm::vec2 TexCoordMax;
+		};
+
+		struct GlyphRun
+		{
+			std::vector<GlyphQuad> Quads;
+			float Width = 0.f;
+			uint32_t LineCount = 1;
+		};
+	public:
+		Font(const std::string& path, AtlasType atlasType = AtlasType::DistanceField, float distanceRange = 8.f);
+
+		// Lays out text (UTF-8, '\n' starts a new line) with advances and kerning. Runs are cached by
+		// string, so redrawing the same labels every frame does no layout work.
+		const GlyphRun& GetGlyphRun(const std::string& text);
+
+		const Ref<Texture2D>& GetAtlasTexture() const { return m_AtlasTexture; }
+		const std::string& GetName() const { return m_Name; }
+
+		static Ref<Font> Create(const std::string& path, AtlasType atlasType = AtlasType::DistanceField, float distanceRange = 8.f);
+	private:
+		struct Glyph
+		{
+			glm::vec2 Offset;
+			glm::vec2 Size;
+			glm::vec2 TexCoordMin;
+			glm::vec2 TexCoordMax;
+			float Advance = 0.f;
+		};
+
+		bool LoadDescription(const std::string& path, std::string& pagePath);
+		bool LoadAtlas(const std::string& pagePath, AtlasType atlasType, float distanceRange);
+		const Glyph* FindGlyph(uint32_t codepoint) const;
+		float GetKerning(uint32_t first, uint32_t second) const;
+	private:
+		std::string m_Name;
+		float m_LineHeight = 1.f;
+		float m_Base = 0.f;
+		glm::vec2 m_AtlasSize = glm::vec2(1.f);
+		Ref<Texture2D> m_AtlasTexture;
+
+		// ASCII glyphs are looked up directly, everything else through the map
+		std::array<int32_t, 128> m_AsciiGlyphs;
+		std::unordered_map<uint32_t, uint32_t> m_GlyphIndices;
+		std::vector<Glyph> m_Glyphs;
+		std::unordered_map<uint64_t, float> m_Kerning;
+
+		std::unordered_map<std::string, GlyphRun> m_RunCache;
+	};
+}
@@ -0,0 +1,140 @@
+#include "engine_pch.h"
+#include "GPUParticleSystem.h"
+
+#include "RenderCommand.h"
+#include "Renderer.h"
+
+namespace Engine
+{
+	// Must match local_size_x in gpuParticleSimulate.glsl
+	static const uint32_t SimulateGroupSize = 256;
+
+	// Storage block bindings shared by both particle shaders
+	enum GPUParticleBinding : uint32_t
+	{
+		GPUParticleBinding_Input = 0,
+		GPUParticleBinding_Output = 1,
+		GPUParticleBinding_Commands = 2,
+		GPUParticleBinding_Emitted = 3
+	};
+
+	GPUParticleSystem::GPUParticleSystem(uint32_t maxParticles, uint32_t maxEmitPerFrame)
+		:m_Capacity(maxParticles), m_MaxEmitPerFrame(maxEmitPerFrame)
+	{
+		m_Emitted.reserve(maxEmitPerFrame);
+
+		for (auto& particles : m_Particles)
+			particles.reset(ShaderStorageBuffer::Create(maxParticles * sizeof(GPUParticle)));
+		m_EmitBuffer.reset(ShaderStorageBuffer::Create(maxEmitPerFrame * sizeof(GPUParticle)));
+
+		// One command per particle buffer; a quad is 6 vertices and the instance count is the particle count
+		DrawArraysIndirectCommand commands[2] = {
+			{ 6, 0, 0, 0 },
+			{ 6, 0, 0, 0 },
+		};
+		m_DrawCommands.reset(IndirectBuffer::Create(sizeof(commands), commands));
+
+		m_SimulateShader = Shader::Create("assets/shaders/gpuParticleSimulate.glsl");
+		UniformHandle<int>(m_SimulateShader, "u_Capacity"_sid).Set((int)maxParticles);
+		m_DeltaTimeUniform = UniformHandle<float>(m_SimulateShader, "u_DeltaTime"_sid);
+		m_EmitCountUniform = UniformHandle<int>(m_SimulateShader, "u_EmitCount"_sid);
+		m_InputCommandUniform = UniformHandle<int>(m_SimulateShader, "u_InputCommand"_sid);
+		m_OutputCommandUniform = UniformHandle<int>(m_SimulateShader, "u_OutputCommand"_sid);
+		m_RenderShader = Shader::Create("assets/shaders/gpuParticleShader.glsl");
+		m_EmptyVertexArray = VertexArray::Create();
+	}
+
+	float GPUParticleSystem::RandomFloat()
+	{
+		// xorshift32
+		m_RandomState ^= m_RandomState << 13;
+		m_RandomState ^= m_RandomState >> 17;
+		m_RandomState ^= m_RandomState << 5;
+		return (float)(m_RandomState >> 8) * (1.f / 16777216.f);
+	}
+
+	void GPUParticleSystem::Emit(const ParticleProps& props, uint32_t count)
+	{
+		count = std::min(count, m_MaxEmitPerFrame - (uint32_t)m_Emitted.size());
+		float inverseLifeTime = 1.f / std::max(props.LifeTime, 1e-4f);
+
+		for (uint32_t n = 0; n < count; n++)
+		{
+			float size = props.SizeBegin + props.SizeVariation * (RandomFloat() - .5f);
+			glm::vec2 velocity = {
+				props.Velocity.x + props.VelocityVariation.x * (RandomFloat() - .5f),
+				props.Velocity.y + props.VelocityVariation.y * (RandomFloat() - .5f)
+			};
+
+			GPUParticle particle;
+			particle.PositionVelocity = { props.Position.x, props.Position.y, velocity.x, velocity.y };
+			particle.Color = props.ColorBegin;
+			particle.ColorVelocity = {
+				(props.ColorEnd.r - props.ColorBegin.r) * inverseLifeTime,
+				(props.ColorEnd.g - props.ColorBegin.g) * inverseLifeTime,
+				(props.ColorEnd.b - props.ColorBegin.b) * inverseLifeTime,
+				(props.ColorEnd.a - props.ColorBegin.a) * inverseLifeTime
+			};
+			particle.SizeRotation = {
+				size, (props.SizeEnd - size) * inverseLifeTime,
+				RandomFloat() * 6.2831853f, props.AngularVelocity + props.AngularVelocityVariation * (RandomFloat() * 2.f - 1.f)
+			};
+			particle.Life = { props.LifeTime, 0.f, 0.f, 0.f };
+			m_Emitted.push_back(particle);
+		}
+	}
+
+	void GPUParticleSystem::OnUpdate(Timestep ts)
+	{
+		RenderCommand::RequireContext("GPUParticleSystem");
+		uint32_t input = m_Current;
+		uint32_t output = 1 - m_Current;
+		uint32_t emitCount = (uint32_t)m_Emitted.size();
+
+		// The output instance count is the append counter of this pass; the previous pass wrote the command
+		// buffer through a storage block, which a clear only sees after a buffer update barrier
+		RenderCommand::InsertMemoryBarrier(MemoryBarrier_BufferUpdate);
+		m_DrawCommands->ClearData(output * sizeof(DrawArraysIndirectCommand) + offsetof(DrawArraysIndirectCommand, InstanceCount), sizeof(uint32_t));
+		if (emitCount)
+			m_EmitBuffer->SetData(m_Emitted.data(), emitCount * sizeof(GPUParticle));
+		m_Emitted.clear();
+
+		m_Particles[input]->BindBase(GPUParticleBinding_Input);
+		m_Particles[output]->BindBase(GPUParticleBinding_Output);
+		m_DrawCommands->BindBase(GPUParticleBinding_Commands);
+		m_EmitBuffer->BindBase(GPUParticleBinding_Emitted);
+
+		m_SimulateShader->Bind();
+		m_DeltaTimeUniform.Set(ts);
+		m_EmitCountUniform.Set((int)emitCount);
+		m_InputCommandUniform.Set((int)input);
+		m_OutputCommandUniform.Set((int)output);
+
+		// The live count is only known on the GPU, so every slot of the pool gets an invocation
+		// followed by one per emitted particle; the surplus returns immediately
+		uint32_t invocations = m_Capacity + emitCount;
+		RenderCommand::DispatchCompute((invocations + SimulateGroupSize - 1) / SimulateGroupSize);
+		RenderCommand::InsertMemoryBarrier(MemoryBarrier_ShaderStorage | MemoryBarrier_Command);
+
+		m_Current = output;
+	}
+
+	uint32_t GPUParticleSystem::ReadParticleCount() const
+	{
+		RenderCommand::RequireContext("GPUParticleSystem");
+		RenderCommand::InsertMemoryBarrier(MemoryBarrier_BufferUpdate);
+		uint32_t count;
+		m_DrawCommands->GetData(&count, sizeof(count), m_Current * sizeof(DrawArraysIndirectCommand) + offsetof(DrawArraysIndirectCommand, InstanceCount));
+		return count;
+	}
+
+	void GPUParticleSystem::OnRender(const OrthographicCamera& camera)
+	{
+		RenderCommand::RequireContext("GPUParticleSystem");
+		m_Particles[m_Current]->BindBase(GPUParticleBinding_Input);
+
+		Renderer::SetSceneCamera(camera);
+		m_RenderShader->Bind();
+		RenderCommand::DrawArraysIndirect(m_EmptyVertexArray, m_DrawCommands, m_Current * sizeof(DrawArraysIndirectCommand));
+	}
+}
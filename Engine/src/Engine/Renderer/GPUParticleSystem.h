@@ -0,0 +1,68 @@
+#pragma once
+#include "ParticleSystem.h"
+#include "Buffer.h"
+
+namespace Engine
+{
+	// Particles simulated entirely on the GPU, for pools too large for ParticleSystem.
+	//
+	// State lives in two storage buffers used in turn. Each update, a compute shader ages the particles
+	// of one buffer and appends the survivors, followed by the particles emitted this frame, to the other
+	// one. The append index is an atomic counter that doubles as the instance count of an indirect draw
+	// command, so the CPU never reads the particle count back.
+	//
+	// Needs OpenGL 4.3 compute shaders and storage buffers in the vertex stage; Mesa's llvmpipe provides
+	// both, so it runs without a GPU.
+	class GPUParticleSystem
+	{
+	public:
+		GPUParticleSystem(uint32_t maxParticles, uint32_t maxEmitPerFrame = 4096);
+
+		GPUParticleSystem(const GPUParticleSystem&) = delete;
+		GPUParticleSystem& operator=(const GPUParticleSystem&) = delete;
+
+		// Queues particles for the next OnUpdate; those beyond maxEmitPerFrame are dropped
+		void Emit(const ParticleProps& props, uint32_t count = 1);
+
+		void OnUpdate(Timestep ts);
+		// Alpha blended over whatever has been drawn already
+		void OnRender(const OrthographicCamera& camera);
+
+		uint32_t GetCapacity() const { return m_Capacity; }
+		// Reads the live count back from the draw command, stalling until the last OnUpdate has run on the GPU.
+		// For debugging and tests only.
+		uint32_t ReadParticleCount() const;
+	private:
+		float RandomFloat();
+	private:
+		// Matches struct Particle in the particle shaders (std430)
+		struct GPUParticle
+		{
+			glm::vec4 PositionVelocity;
+			glm::vec4 Color;
+			glm::vec4 ColorVelocity;
+			// Size, size velocity, rotation, angular velocity
+			glm::vec4 SizeRotation;
+			// Remaining life time in x
+			glm::vec4 Life;
+		};
+
+		uint32_t m_Capacity;
+		uint32_t m_MaxEmitPerFrame;
+		std::vector<GPUParticle> m_Emitted;
+		uint32_t m_RandomState = 0x9e3779b9;
+
+		// m_Particles[m_Current] and command m_Current hold the live particles
+		Ref<ShaderStorageBuffer> m_Particles[2];
+		Ref<ShaderStorageBuffer> m_EmitBuffer;
+		Ref<IndirectBuffer> m_DrawCommands;
+		uint32_t m_Current = 0;
+
+		Ref<Shader> m_SimulateShader;
+		UniformHandle<float> m_DeltaTimeUniform;
+		UniformHandle<int> m_EmitCountUniform, m_InputCommandUniform, m_OutputCommandUniform;
+		Ref<Shader> m_RenderShader;
+		// Quads are generated from gl_VertexID, no attributes needed
+		Ref<VertexArray> m_EmptyVertexArray;
+	};
+}
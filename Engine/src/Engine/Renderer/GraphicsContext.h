@@ -8,5 +8,9 @@ namespace Engine
 		virtual ~GraphicsContext() {}
 		virtual void Init() = 0;
 		virtual void SwapBuffers() = 0;
+
+		// A context is current on at most one thread; these hand it from one thread to another
+		virtual void MakeCurrent() = 0;
+		virtual void ReleaseCurrent() = 0;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "engine_pch.h"
+#include "HotReload.h"
+
+#include "RenderCommand.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "Engine/Core/FileWatcher.h"
+
+namespace Engine
+{
+	struct HotReloadStorage
+	{
+		Scope<FileWatcher> watcher;
+
+		// Guards the watcher and the registries, assets can be created on any thread that records
+		std::mutex mutex;
+		std::unordered_map<std::string, std::vector<std::weak_ptr<Shader>>> shaders;
+		std::unordered_map<std::string, std::vector<std::weak_ptr<Texture2D>>> textures;
+		// Shader include files to the files of the shaders that include them
+		std::unordered_map<std::string, std::unordered_set<std::string>> includers;
+
+		// Assets with a rebuild in flight
+		std::vector<Ref<Shader>> reloadingShaders;
+		std::vector<Ref<Texture2D>> reloadingTextures;
+	};
+
+	static HotReloadStorage s_data;
+
+	template<typename T>
+	static void StartReloads(std::vector<std::weak_ptr<T>>& assets, std::vector<Ref<T>>& reloading)
+	{
+		for (size_t i = 0; i < assets.size();)
+		{
+			Ref<T> asset = assets[i].lock();
+			if (!asset)
+			{
+				assets[i] = assets.back();
+				assets.pop_back();
+				continue;
+			}
+
+			// Reloading again while a rebuild is in flight restarts it with the newest file
+			asset->Reload();
+			if (std::find(reloading.begin(), reloading.end(), asset) == reloading.end())
+				reloading.push_back(asset);
+			i++;
+		}
+	}
+
+	template<typename T>
+	static void FinishReloads(std::vector<Ref<T>>& reloading)
+	{
+		for (size_t i = 0; i < reloading.size();)
+		{
+			if (reloading[i]->UpdateReload())
+			{
+				reloading[i] = reloading.back();
+				reloading.pop_back();
+			}
+			else
+				i++;
+		}
+	}
+
+	static void ProcessReloads(HotReloadStorage* const& data)
+	{
+		std::lock_guard<std::mutex> lock(data->mutex);
+		if (!data->watcher)
+			return;
+
+		for (const std::string& path : data->watcher->TakeChanges())
+		{
+			EG_CORE_INFO("Reloading {0}", path);
+
+			auto shaders = data->shaders.find(path);
+			if (shaders != data->shaders.end())
+				StartReloads(shaders->second, data->reloadingShaders);
+
+			auto includers = data->includers.find(path);
+			if (includers != data->includers.end())
+			{
+				for (const std::string& shaderPath : includers->second)
+				{
+					shaders = data->shaders.find(shaderPath);
+					if (shaders != data->shaders.end())
+						StartReloads(shaders->second, data->reloadingShaders);
+				}
+			}
+
+			auto textures = data->textures.find(path);
+			if (textures != data->textures.end())
+				StartReloads(textures->second, data->reloadingTextures);
+		}
+
+		FinishReloads(data->reloadingShaders);
+		FinishReloads(data->reloadingTextures);
+	}
+
+	void HotReload::Start(uint32_t pollIntervalMilliseconds)
+	{
+		std::lock_guard<std::mutex> lock(s_data.mutex);
+		if (s_data.watcher)
+			return;
+
+		s_data.watcher.reset(new FileWatcher(pollIntervalMilliseconds));
+		for (auto& kv : s_data.shaders)
+			s_data.watcher->Watch(kv.first);
+		for (auto& kv : s_data.textures)
+			s_data.watcher->Watch(kv.first);
+		for (auto& kv : s_data.includers)
+			s_data.watcher->Watch(kv.first);
+	}
+
+	void HotReload::Stop()
+	{
+		// Rebuilds still in flight are dropped, their assets stay as they are
+		std::lock_guard<std::mutex> lock(s_data.mutex);
+		s_data.watcher.reset();
+		s_data.reloadingShaders.clear();
+		s_data.reloadingTextures.clear();
+	}
+
+	bool HotReload::IsRunning()
+	{
+		std::lock_guard<std::mutex> lock(s_data.mutex);
+		return s_data.watcher != nullptr;
+	}
+
+	void HotReload::Register(const Ref<Shader>& shader)
+	{
+		const std::string& path = shader->GetFilePath();
+		if (path.empty())
+			return;
+
+		std::lock_guard<std::mutex> lock(s_data.mutex);
+		s_data.shaders[path].push_back(shader);
+		if (s_data.watcher)
+			s_data.watcher->Watch(path);
+	}
+
+	void HotReload::RegisterIncludes(const std::string& shaderPath, const std::vector<std::string>& includes)
+	{
+		std::lock_guard<std::mutex> lock(s_data.mutex);
+		for (const std::string& include : includes)
+		{
+			s_data.includers[include].insert(shaderPath);
+			if (s_data.watcher)
+				s_data.watcher->Watch(include);
+		}
+	}
+
+	void HotReload::Register(const Ref<Texture2D>& texture)
+	{
+		const std::string& path = texture->GetPath();
+		if (path.empty())
+			return;
+
+		std::lock_guard<std::mutex> lock(s_data.mutex);
+		s_data.textures[path].push_back(texture);
+		if (s_data.watcher)
+			s_data.watcher->Watch(path);
+	}
+
+	void HotReload::Update()
+	{
+		{
+			// Released before submitting, ProcessReloads runs right here when no frame is recorded
+			std::lock_guard<std::mutex> lock(s_data.mutex);
+			if (!s_data.watcher)
+				return;
+		}
+
+		HotReloadStorage* data = &s_data;
+		RenderCommand::Submit(ProcessReloads, data);
+	}
+}
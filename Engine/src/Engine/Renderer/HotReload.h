@@ -0,0 +1,28 @@
+#pragma once
+
+namespace Engine
+{
+	class Shader;
+	class Texture2D;
+
+	// Rebuilds shaders and textures loaded from files when the files, or files a shader includes, change on disk. Files are read and
+	// decoded in the background and shaders link without being waited on; Update swaps finished assets
+	// in at a frame boundary. A rebuild that fails keeps the asset as it was.
+	class HotReload
+	{
+	public:
+		static void Start(uint32_t pollIntervalMilliseconds = 250);
+		static void Stop();
+		static bool IsRunning();
+
+		// Called by the factories of file-backed assets; only weak references are kept
+		static void Register(const Ref<Shader>& shader);
+		static void Register(const Ref<Texture2D>& texture);
+		// Called whenever a shader file is read, from any thread; a change to one of the includes
+		// reloads every shader built from shaderPath
+		static void RegisterIncludes(const std::string& shaderPath, const std::vector<std::string>& includes);
+
+		// Called once per frame by Application before the layers update
+		static void Update();
+	};
+}
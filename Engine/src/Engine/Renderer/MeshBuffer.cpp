@@ -0,0 +1,60 @@
+#include "engine_pch.h"
+#include "MeshBuffer.h"
+
+namespace Engine
+{
+	MeshBuffer::MeshBuffer(const BufferLayout& layout)
+		:m_Layout(layout)
+	{
+	}
+
+	uint32_t MeshBuffer::AddMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount)
+	{
+		uint32_t stride = m_Layout.GetStride();
+		EG_CORE_ASSERT(stride, "Mesh buffer has no layout!");
+
+		Mesh mesh;
+		mesh.IndexCount = indexCount;
+		mesh.FirstIndex = (uint32_t)m_Indices.size();
+		mesh.BaseVertex = (uint32_t)(m_Vertices.size() / stride);
+
+		const uint8_t* vertexBytes = (const uint8_t*)vertices;
+		m_Vertices.insert(m_Vertices.end(), vertexBytes, vertexBytes + vertexCount * stride);
+		m_Indices.insert(m_Indices.end(), indices, indices + indexCount);
+		for (uint32_t i = 0; i < indexCount; i++)
+			m_MaxIndex = std::max(m_MaxIndex, indices[i]);
+
+		m_Meshes.push_back(mesh);
+		m_Dirty = true;
+		return (uint32_t)m_Meshes.size() - 1;
+	}
+
+	const Ref<VertexArray>& MeshBuffer::GetVertexArray()
+	{
+		if (!m_Dirty)
+			return m_VertexArray;
+		m_Dirty = false;
+
+		// Meshes are usually all added up front, so rebuilding everything keeps the buffers exactly sized
+		m_VertexArray = VertexArray::Create();
+
+		Ref<VertexBuffer> vertexBuffer;
+		vertexBuffer.reset(VertexBuffer::Create((uint32_t)m_Vertices.size()));
+		vertexBuffer->SetData(m_Vertices.data(), (uint32_t)m_Vertices.size());
+		vertexBuffer->SetLayout(m_Layout);
+		m_VertexArray->AddVertexBuffer(vertexBuffer);
+
+		// Indices are relative to each mesh's base vertex, so they only have to fit the largest mesh
+		Ref<IndexBuffer> indexBuffer;
+		if (m_MaxIndex <= 0xffff)
+		{
+			std::vector<uint16_t> indices(m_Indices.begin(), m_Indices.end());
+			indexBuffer.reset(IndexBuffer::Create(indices.data(), (uint32_t)indices.size()));
+		}
+		else
+			indexBuffer.reset(IndexBuffer::Create(m_Indices.data(), (uint32_t)m_Indices.size()));
+		m_VertexArray->SetIndexBuffer(indexBuffer);
+
+		return m_VertexArray;
+	}
+}
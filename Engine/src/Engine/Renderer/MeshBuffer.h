@@ -0,0 +1,40 @@
+#pragma once
+#include "VertexArray.h"
+
+namespace Engine
+{
+	// Packs the geometry of many meshes into one vertex buffer and one index buffer. Meshes that share a
+	// MeshBuffer and a shader are drawn by Renderer::EndScene with a single multi-draw call.
+	class MeshBuffer
+	{
+	public:
+		struct Mesh
+		{
+			uint32_t IndexCount;
+			uint32_t FirstIndex;
+			uint32_t BaseVertex;
+		};
+
+		MeshBuffer(const BufferLayout& layout);
+
+		// Copies the geometry and returns the mesh handle. Indices count from the mesh's own first vertex,
+		// vertices follow the layout given at construction.
+		uint32_t AddMesh(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+
+		const Mesh& GetMesh(uint32_t mesh) const { return m_Meshes[mesh]; }
+		uint32_t GetMeshCount() const { return (uint32_t)m_Meshes.size(); }
+
+		// Re-uploads the buffers if meshes were added since the last call
+		const Ref<VertexArray>& GetVertexArray();
+	private:
+		BufferLayout m_Layout;
+		std::vector<uint8_t> m_Vertices;
+		std::vector<uint32_t> m_Indices;
+		std::vector<Mesh> m_Meshes;
+		// Indices are uploaded as 16-bit while every mesh has fewer than 65536 vertices
+		uint32_t m_MaxIndex = 0;
+
+		Ref<VertexArray> m_VertexArray;
+		bool m_Dirty = true;
+	};
+}
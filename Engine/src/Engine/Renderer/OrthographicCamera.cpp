@@ -6,21 +6,59 @@
 namespace Engine
 {
 	OrthographicCamera::OrthographicCamera(float left, float right, float bottom, float top)
-		:m_Project(glm::ortho(left, right, bottom, top, -1.f, 1.f)), m_View(1.f)
+		:m_Left(left), m_Right(right), m_Bottom(bottom), m_Top(top), m_Project(glm::ortho(left, right, bottom, top, -1.f, 1.f)), m_View(1.f)
 	{
-		m_ViewProjection = m_Project * m_View;
+	}
+
+	void OrthographicCamera::SetPosition(const glm::vec3& position)
+	{
+		if (position.x == m_Position.x && position.y == m_Position.y && position.z == m_Position.z)
+			return;
+		m_Position = position;
+		m_Dirty = true;
+	}
+
+	void OrthographicCamera::SetRotation(const float rotation)
+	{
+		if (rotation == m_Rotation)
+			return;
+		m_Rotation = rotation;
+		m_Dirty = true;
 	}
 
 	void OrthographicCamera::SetProjection(float left, float right, float bottom, float top)
 	{
+		m_Left = left;
+		m_Right = right;
+		m_Bottom = bottom;
+		m_Top = top;
 		m_Project = glm::ortho(left, right, bottom, top, -1.f, 1.f);
-		m_ViewProjection = m_Project * m_View;
+		m_Dirty = true;
 	}
 
-	void OrthographicCamera::RecalculateViewMatrix()
+	void OrthographicCamera::RecalculateViewMatrix() const
 	{
-		glm::mat4 transform = glm::translate(glm::mat4(1.f), m_Position) * glm::rotate(glm::mat4(1.f), glm::radians(m_Rotation), glm::vec3(0.f, 0.f, 1.f));
-		m_View = glm::inverse(transform);
+		float radians = glm::radians(m_Rotation);
+		float c = cosf(radians);
+		float s = sinf(radians);
+
+		// inverse(translate * rotate) = transpose(rotate) * translate(-position)
+		m_View = glm::mat4(1.f);
+		m_View[0][0] = c;  m_View[0][1] = -s;
+		m_View[1][0] = s;  m_View[1][1] = c;
+		m_View[3][0] = -(c * m_Position.x + s * m_Position.y);
+		m_View[3][1] = -(-s * m_Position.x + c * m_Position.y);
+		m_View[3][2] = -m_Position.z;
 		m_ViewProjection = m_Project * m_View;
+
+		// Rotate the view rectangle into world space and take its extent on each axis
+		glm::vec2 localCenter = { (m_Left + m_Right) * .5f, (m_Bottom + m_Top) * .5f };
+		glm::vec2 halfSize = { fabsf(m_Right - m_Left) * .5f, fabsf(m_Top - m_Bottom) * .5f };
+		glm::vec2 center = { m_Position.x + c * localCenter.x - s * localCenter.y, m_Position.y + s * localCenter.x + c * localCenter.y };
+		glm::vec2 extent = { fabsf(c) * halfSize.x + fabsf(s) * halfSize.y, fabsf(s) * halfSize.x + fabsf(c) * halfSize.y };
+		m_Bounds.Min = { center.x - extent.x, center.y - extent.y };
+		m_Bounds.Max = { center.x + extent.x, center.y + extent.y };
+
+		m_Dirty = false;
 	}
-}
\ No newline at end of file
+}
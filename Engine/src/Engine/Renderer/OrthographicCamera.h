@@ -5,27 +5,41 @@ namespace Engine
 {
 	class OrthographicCamera
 	{
+	public:
+		// World-space axis-aligned box around everything the camera can see
+		struct Bounds
+		{
+			glm::vec2 Min = glm::vec2(0.f);
+			glm::vec2 Max = glm::vec2(0.f);
+		};
 	public:
 		OrthographicCamera(float left, float right, float bottom, float top);
 
 		const glm::vec3& GetPosition() const { return m_Position; }
-		void SetPosition(const glm::vec3& position) { m_Position = position; RecalculateViewMatrix(); }
+		void SetPosition(const glm::vec3& position);
 
+		// Rotation is in degrees, counter-clockwise about the z axis
 		const float GetRotation() const { return m_Rotation; }
-		void SetRotation(const float radiance) { m_Rotation = radiance; RecalculateViewMatrix(); }
+		void SetRotation(const float rotation);
 
 		void SetProjection(float left, float right, float bottom, float top);
 
+		// The view matrix and bounds are only rebuilt when first read after a change
 		const glm::mat4& GetProjectionMatrix() const { return m_Project; }
-		const glm::mat4& GetViewMatrix() const { return m_View; }
-		const glm::mat4& GetViewProjectionMatrix() const { return m_ViewProjection; }
+		const glm::mat4& GetViewMatrix() const { RecalculateIfDirty(); return m_View; }
+		const glm::mat4& GetViewProjectionMatrix() const { RecalculateIfDirty(); return m_ViewProjection; }
+		const Bounds& GetVisibleBounds() const { RecalculateIfDirty(); return m_Bounds; }
 
 	private:
-		void RecalculateViewMatrix();
+		void RecalculateIfDirty() const { if (m_Dirty) RecalculateViewMatrix(); }
+		void RecalculateViewMatrix() const;
 	private:
+		float m_Left, m_Right, m_Bottom, m_Top;
 		glm::mat4 m_Project;
-		glm::mat4 m_View;
-		glm::mat4 m_ViewProjection;
+		mutable glm::mat4 m_View;
+		mutable glm::mat4 m_ViewProjection;
+		mutable Bounds m_Bounds;
+		mutable bool m_Dirty = true;
 
 		glm::vec3 m_Position = glm::vec3(0.f);
 		float m_Rotation = 0.f;
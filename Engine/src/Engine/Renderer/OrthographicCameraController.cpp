@@ -12,27 +12,40 @@ namespace Engine
 
 	void OrthographicCameraController::onUpdate(Timestep ts)
 	{
+		glm::vec3 camPos = m_camPos;
 		if (Input::IsKeyPressed(Key::A))
-			m_camPos.x -= m_camSpeed * ts;
+			camPos.x -= m_camSpeed * ts;
 
 		if (Input::IsKeyPressed(Key::D))
-			m_camPos.x += m_camSpeed * ts;
+			camPos.x += m_camSpeed * ts;
 
 		if (Input::IsKeyPressed(Key::S))
-			m_camPos.y -= m_camSpeed * ts;
+			camPos.y -= m_camSpeed * ts;
 
 		if (Input::IsKeyPressed(Key::W))
-			m_camPos.y += m_camSpeed * ts;
+			camPos.y += m_camSpeed * ts;
 
-		if (Input::IsKeyPressed(Key::Q))
-			m_camAngle += m_camRotSpeed * ts * m_rotation;
+		float camAngle = m_camAngle;
+		if (m_rotation)
+		{
+			if (Input::IsKeyPressed(Key::Q))
+				camAngle += m_camRotSpeed * ts;
 
-		if (Input::IsKeyPressed(Key::E))
-			m_camAngle -= m_camRotSpeed * ts * m_rotation;
+			if (Input::IsKeyPressed(Key::E))
+				camAngle -= m_camRotSpeed * ts;
+		}
 
-		m_camera.SetPosition(m_camPos);
-		if (m_camAngle)
+		// Only touch the camera when something moved, so its cached matrices stay valid
+		if (camPos.x != m_camPos.x || camPos.y != m_camPos.y)
+		{
+			m_camPos = camPos;
+			m_camera.SetPosition(m_camPos);
+		}
+		if (camAngle != m_camAngle)
+		{
+			m_camAngle = camAngle;
 			m_camera.SetRotation(m_camAngle);
+		}
 	}
 
 	void OrthographicCameraController::onEvent(Event& e)
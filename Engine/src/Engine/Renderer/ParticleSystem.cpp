@@ -0,0 +1,259 @@
+#include "engine_pch.h"
+#include "ParticleSystem.h"
+
+#include "RenderCommand.h"
+#include "Renderer.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/SIMD.h"
+
+namespace Engine
+{
+	// Particles per job; a multiple of 4 so every range starts on a SIMD lane group
+	static const uint32_t ParticleJobSize = 4096;
+
+	struct ParticleInstance
+	{
+		// Position x, y, size and rotation
+		glm::vec4 Transform;
+		glm::vec4 Color;
+	};
+
+	struct ParticleJob
+	{
+		float* const* Streams;
+		float DeltaTime;
+		uint32_t Count;
+		ParticleInstance* Instances;
+	};
+
+	// Ranges may run past their end up to the next multiple of 4: the pool is padded for that and
+	// the lanes past the particle count are never read back
+	static void UpdateParticles(void* context, uint32_t begin, uint32_t end)
+	{
+		const ParticleJob& job = *(const ParticleJob*)context;
+		float* const* streams = job.Streams;
+
+#ifdef EG_SIMD_X86
+		__m128 dt = _mm_set1_ps(job.DeltaTime);
+		for (uint32_t stream = 0; stream < ParticleSystem::Life; stream += 2)
+		{
+			float* value = streams[stream];
+			const float* rate = streams[stream + 1];
+			for (uint32_t i = begin; i < end; i += 4)
+				_mm_store_ps(value + i, _mm_add_ps(_mm_load_ps(value + i), _mm_mul_ps(_mm_load_ps(rate + i), dt)));
+		}
+		float* life = streams[ParticleSystem::Life];
+		for (uint32_t i = begin; i < end; i += 4)
+			_mm_store_ps(life + i, _mm_sub_ps(_mm_load_ps(life + i), dt));
+#else
+		for (uint32_t stream = 0; stream < ParticleSystem::Life; stream += 2)
+		{
+			float* value = streams[stream];
+			const float* rate = streams[stream + 1];
+			for (uint32_t i = begin; i < end; i++)
+				value[i] += rate[i] * job.DeltaTime;
+		}
+		float* life = streams[ParticleSystem::Life];
+		for (uint32_t i = begin; i < end; i++)
+			life[i] -= job.DeltaTime;
+#endif
+	}
+
+	// Transposes the SoA pool into interleaved instances
+	static void WriteInstances(void* context, uint32_t begin, uint32_t end)
+	{
+		const ParticleJob& job = *(const ParticleJob*)context;
+		float* const* streams = job.Streams;
+		ParticleInstance* instances = job.Instances;
+
+		uint32_t i = begin;
+#ifdef EG_SIMD_X86
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 x = _mm_load_ps(streams[ParticleSystem::PositionX] + i);
+			__m128 y = _mm_load_ps(streams[ParticleSystem::PositionY] + i);
+			__m128 size = _mm_load_ps(streams[ParticleSystem::Size] + i);
+			__m128 rotation = _mm_load_ps(streams[ParticleSystem::Rotation] + i);
+			_MM_TRANSPOSE4_PS(x, y, size, rotation);
+
+			__m128 r = _mm_load_ps(streams[ParticleSystem::ColorR] + i);
+			__m128 g = _mm_load_ps(streams[ParticleSystem::ColorG] + i);
+			__m128 b = _mm_load_ps(streams[ParticleSystem::ColorB] + i);
+			__m128 a = _mm_load_ps(streams[ParticleSystem::ColorA] + i);
+			_MM_TRANSPOSE4_PS(r, g, b, a);
+
+			// The destination is write-combined mapped memory, so write it strictly in order
+			float* dest = (float*)(instances + i);
+			_mm_storeu_ps(dest + 0, x);
+			_mm_storeu_ps(dest + 4, r);
+			_mm_storeu_ps(dest + 8, y);
+			_mm_storeu_ps(dest + 12, g);
+			_mm_storeu_ps(dest + 16, size);
+			_mm_storeu_ps(dest + 20, b);
+			_mm_storeu_ps(dest + 24, rotation);
+			_mm_storeu_ps(dest + 28, a);
+		}
+#endif
+		for (; i < end; i++)
+		{
+			instances[i].Transform = { streams[ParticleSystem::PositionX][i], streams[ParticleSystem::PositionY][i], streams[ParticleSystem::Size][i], streams[ParticleSystem::Rotation][i] };
+			instances[i].Color = { streams[ParticleSystem::ColorR][i], streams[ParticleSystem::ColorG][i], streams[ParticleSystem::ColorB][i], streams[ParticleSystem::ColorA][i] };
+		}
+	}
+
+	ParticleSystem::ParticleSystem(uint32_t maxParticles)
+	{
+		// Padded so SIMD loops may always finish a group of 8
+		m_Capacity = (maxParticles + 7) & ~7u;
+		m_Storage = (float*)SIMD::AlignedAlloc((size_t)m_Capacity * StreamCount * sizeof(float), 32);
+		memset(m_Storage, 0, (size_t)m_Capacity * StreamCount * sizeof(float));
+		for (uint32_t stream = 0; stream < StreamCount; stream++)
+			m_Streams[stream] = m_Storage + (size_t)stream * m_Capacity;
+
+		float corners[] = {
+			-.5f, -.5f,
+			 .5f, -.5f,
+			 .5f,  .5f,
+			-.5f,  .5f,
+		};
+		Ref<VertexBuffer> cornerBuffer;
+		cornerBuffer.reset(VertexBuffer::Create(corners, sizeof(corners)));
+		cornerBuffer->SetLayout({
+			{ShaderDataType::Float2, "a_Corner"},
+		});
+
+		m_InstanceBuffer.reset(StreamingBuffer::Create(m_Capacity * sizeof(ParticleInstance), 3));
+		m_InstanceBuffer->SetLayout({
+			{ShaderDataType::Float4, "a_Transform", false, 1},
+			{ShaderDataType::Float4, "a_Color", false, 1},
+		});
+		Ref<VertexBuffer> instanceBuffer = m_InstanceBuffer;
+
+		Ref<IndexBuffer> indexBuffer = IndexBuffer::GetQuadIndexBuffer(1);
+
+		m_VertexArray = VertexArray::Create();
+		m_VertexArray->AddVertexBuffer(cornerBuffer);
+		m_VertexArray->AddVertexBuffer(instanceBuffer);
+		m_VertexArray->SetIndexBuffer(indexBuffer);
+
+		m_Shader = Shader::Create("assets/shaders/particleShader.glsl");
+	}
+
+	ParticleSystem::~ParticleSystem()
+	{
+		SIMD::AlignedFree(m_Storage);
+	}
+
+	float ParticleSystem::RandomFloat()
+	{
+		// xorshift32
+		m_RandomState ^= m_RandomState << 13;
+		m_RandomState ^= m_RandomState >> 17;
+		m_RandomState ^= m_RandomState << 5;
+		return (float)(m_RandomState >> 8) * (1.f / 16777216.f);
+	}
+
+	void ParticleSystem::Emit(const ParticleProps& props, uint32_t count)
+	{
+		count = std::min(count, m_Capacity - m_Count);
+		float inverseLifeTime = 1.f / std::max(props.LifeTime, 1e-4f);
+
+		for (uint32_t n = 0; n < count; n++)
+		{
+			uint32_t i = m_Count++;
+			float size = props.SizeBegin + props.SizeVariation * (RandomFloat() - .5f);
+
+			m_Streams[PositionX][i] = props.Position.x;
+			m_Streams[PositionY][i] = props.Position.y;
+			m_Streams[VelocityX][i] = props.Velocity.x + props.VelocityVariation.x * (RandomFloat() - .5f);
+			m_Streams[VelocityY][i] = props.Velocity.y + props.VelocityVariation.y * (RandomFloat() - .5f);
+			m_Streams[Rotation][i] = RandomFloat() * 6.2831853f;
+			m_Streams[AngularVelocity][i] = props.AngularVelocity + props.AngularVelocityVariation * (RandomFloat() * 2.f - 1.f);
+			m_Streams[Size][i] = size;
+			m_Streams[SizeVelocity][i] = (props.SizeEnd - size) * inverseLifeTime;
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				m_Streams[ColorR + c * 2][i] = props.ColorBegin[c];
+				m_Streams[ColorVelocityR + c * 2][i] = (props.ColorEnd[c] - props.ColorBegin[c]) * inverseLifeTime;
+			}
+			m_Streams[Life][i] = props.LifeTime;
+		}
+	}
+
+	void ParticleSystem::OnUpdate(Timestep ts)
+	{
+		if (m_Count == 0)
+			return;
+
+		ParticleJob job = { m_Streams, ts, m_Count, nullptr };
+		JobSystem::ParallelFor(m_Count, ParticleJobSize, UpdateParticles, &job);
+		Compact();
+	}
+
+	// Moves the living particles to the front, keeping their order
+	void ParticleSystem::Compact()
+	{
+		const float* life = m_Streams[Life];
+		uint32_t write = 0;
+		for (uint32_t read = 0; read < m_Count; read += 4)
+		{
+			uint32_t lanes = std::min(m_Count - read, 4u);
+			uint32_t validMask = (1u << lanes) - 1;
+#ifdef EG_SIMD_X86
+			uint32_t aliveMask = (uint32_t)_mm_movemask_ps(_mm_cmpgt_ps(_mm_load_ps(life + read), _mm_setzero_ps())) & validMask;
+#else
+			uint32_t aliveMask = 0;
+			for (uint32_t lane = 0; lane < lanes; lane++)
+				aliveMask |= (life[read + lane] > 0.f ? 1u : 0u) << lane;
+#endif
+			if (aliveMask == 0xf)
+			{
+				// The common case: nothing died so far, or a whole group moves down at once
+				if (write != read)
+				{
+					for (uint32_t stream = 0; stream < StreamCount; stream++)
+					{
+						float* data = m_Streams[stream];
+#ifdef EG_SIMD_X86
+						_mm_storeu_ps(data + write, _mm_load_ps(data + read));
+#else
+						memmove(data + write, data + read, 4 * sizeof(float));
+#endif
+					}
+				}
+				write += 4;
+				continue;
+			}
+
+			for (uint32_t lane = 0; lane < 4; lane++)
+			{
+				if (!(aliveMask & (1u << lane)))
+					continue;
+				for (uint32_t stream = 0; stream < StreamCount; stream++)
+					m_Streams[stream][write] = m_Streams[stream][read + lane];
+				write++;
+			}
+		}
+		m_Count = write;
+	}
+
+	void ParticleSystem::OnRender(const OrthographicCamera& camera)
+	{
+		RenderCommand::RequireContext("ParticleSystem");
+		if (m_Count == 0)
+			return;
+
+		uint32_t dataSize = m_Count * sizeof(ParticleInstance);
+		ParticleJob job = { m_Streams, 0.f, m_Count, (ParticleInstance*)m_InstanceBuffer->BeginWrite(dataSize) };
+		JobSystem::ParallelFor(m_Count, ParticleJobSize, WriteInstances, &job);
+		m_InstanceBuffer->EndWrite(dataSize);
+
+		Renderer::SetSceneCamera(camera);
+		m_Shader->Bind();
+		m_VertexArray->Bind();
+		m_VertexArray->ValidateLayout(*m_Shader);
+		// The instance buffer is the only per-instance stream, so its first vertex is the first instance
+		RenderCommand::DrawIndexedInstanced(m_VertexArray, m_Count, 6, m_InstanceBuffer->GetBaseVertex());
+		m_InstanceBuffer->EndFrame();
+	}
+}
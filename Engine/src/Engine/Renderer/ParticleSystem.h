@@ -0,0 +1,78 @@
+#pragma once
+#include "OrthographicCamera.h"
+#include "VertexArray.h"
+#include "StreamingBuffer.h"
+#include "Shader.h"
+#include "Engine/Core/Timestep.h"
+
+namespace Engine
+{
+	struct ParticleProps
+	{
+		glm::vec2 Position = glm::vec2(0.f);
+		glm::vec2 Velocity = glm::vec2(0.f);
+		glm::vec2 VelocityVariation = glm::vec2(0.f);
+		glm::vec4 ColorBegin = glm::vec4(1.f);
+		glm::vec4 ColorEnd = glm::vec4(1.f);
+		float SizeBegin = 1.f;
+		float SizeEnd = 0.f;
+		float SizeVariation = 0.f;
+		// Radians per second, varied by up to AngularVelocityVariation either way
+		float AngularVelocity = 0.f;
+		float AngularVelocityVariation = 0.f;
+		float LifeTime = 1.f;
+	};
+
+	// Square, untextured particles kept in a fixed-capacity pool.
+	//
+	// Every attribute lives in its own 32-byte aligned array. OnUpdate integrates them with SIMD on the
+	// JobSystem workers, then compacts the survivors in place; OnRender writes the pool straight into a
+	// streaming instance buffer and draws it with one instanced call. Nothing allocates after construction.
+	class ParticleSystem
+	{
+	public:
+		ParticleSystem(uint32_t maxParticles);
+		~ParticleSystem();
+
+		ParticleSystem(const ParticleSystem&) = delete;
+		ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+		// Particles that do not fit in the pool are dropped
+		void Emit(const ParticleProps& props, uint32_t count = 1);
+
+		void OnUpdate(Timestep ts);
+		// Alpha blended over whatever has been drawn already
+		void OnRender(const OrthographicCamera& camera);
+
+		uint32_t GetParticleCount() const { return m_Count; }
+		uint32_t GetCapacity() const { return m_Capacity; }
+	public:
+		// Each value stream is followed by its rate of change per second
+		enum Stream
+		{
+			PositionX = 0, VelocityX,
+			PositionY, VelocityY,
+			Rotation, AngularVelocity,
+			Size, SizeVelocity,
+			ColorR, ColorVelocityR,
+			ColorG, ColorVelocityG,
+			ColorB, ColorVelocityB,
+			ColorA, ColorVelocityA,
+			Life,
+			StreamCount
+		};
+	private:
+		float RandomFloat();
+		void Compact();
+	private:
+		uint32_t m_Capacity;
+		uint32_t m_Count = 0;
+		float* m_Storage = nullptr;
+		float* m_Streams[StreamCount];
+		uint32_t m_RandomState = 0x9e3779b9;
+
+		Ref<VertexArray> m_VertexArray;
+		Ref<StreamingBuffer> m_InstanceBuffer;
+		Ref<Shader> m_Shader;
+	};
+}
@@ -0,0 +1,154 @@
+#include "engine_pch.h"
+#include "QuadTransform.h"
+
+#include "Engine/Core/SIMD.h"
+
+namespace Engine
+{
+	QuadTransformArray::~QuadTransformArray()
+	{
+		SIMD::AlignedFree(m_Memory);
+	}
+
+	void QuadTransformArray::Reserve(uint32_t capacity)
+	{
+		if (capacity <= m_Capacity)
+			return;
+
+		// Keep every component array 32-byte aligned for the AVX2 loads
+		uint32_t stride = (capacity + 7) & ~7u;
+		float* memory = (float*)SIMD::AlignedAlloc(sizeof(float) * stride * 9);
+
+		float** arrays[9] = { &CenterX, &CenterY, &CenterZ, &AxisXx, &AxisXy, &AxisXz, &AxisYx, &AxisYy, &AxisYz };
+		for (uint32_t i = 0; i < 9; i++)
+		{
+			float* array = memory + stride * i;
+			if (m_Capacity)
+				memcpy(array, *arrays[i], sizeof(float) * m_Capacity);
+			*arrays[i] = array;
+		}
+
+		SIMD::AlignedFree(m_Memory);
+		m_Memory = memory;
+		m_Capacity = capacity;
+	}
+
+	static inline void WriteCorner(uint8_t* vertex, float x, float y, float z)
+	{
+		float* position = (float*)vertex;
+		position[0] = x;
+		position[1] = y;
+		position[2] = z;
+	}
+
+	// Component streams of one range of quads, indexed from the first quad of the range
+	struct QuadStreams
+	{
+		const float* Center[3];
+		const float* AxisX[3];
+		const float* AxisY[3];
+	};
+
+	static void TransformQuadsScalar(const QuadStreams& t, uint32_t begin, uint32_t end, uint8_t* vertices, uint32_t vertexStride)
+	{
+		for (uint32_t q = begin; q < end; q++)
+		{
+			uint8_t* vertex = vertices + (size_t)q * 4 * vertexStride;
+			float corners[4][3];
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				// s = x + y, d = x - y gives all four corners with one add or subtract each
+				float s = t.AxisX[c][q] + t.AxisY[c][q];
+				float d = t.AxisX[c][q] - t.AxisY[c][q];
+				corners[0][c] = t.Center[c][q] - s;
+				corners[1][c] = t.Center[c][q] + d;
+				corners[2][c] = t.Center[c][q] + s;
+				corners[3][c] = t.Center[c][q] - d;
+			}
+			for (uint32_t k = 0; k < 4; k++)
+				WriteCorner(vertex + k * vertexStride, corners[k][0], corners[k][1], corners[k][2]);
+		}
+	}
+
+#ifdef EG_SIMD_X86
+	// Scatters lane i of the corner components to quad i of the run starting at vertices
+	template<uint32_t Lanes>
+	static inline void ScatterCorners(const float (&corners)[4][3][Lanes], uint8_t* vertices, uint32_t vertexStride)
+	{
+		for (uint32_t i = 0; i < Lanes; i++)
+		{
+			uint8_t* vertex = vertices + (size_t)i * 4 * vertexStride;
+			for (uint32_t k = 0; k < 4; k++)
+				WriteCorner(vertex + k * vertexStride, corners[k][0][i], corners[k][1][i], corners[k][2][i]);
+		}
+	}
+
+	static uint32_t TransformQuadsSSE(const QuadStreams& t, uint32_t begin, uint32_t end, uint8_t* vertices, uint32_t vertexStride)
+	{
+		alignas(16) float corners[4][3][4];
+
+		uint32_t q = begin;
+		for (; q + 4 <= end; q += 4)
+		{
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				__m128 center = _mm_loadu_ps(t.Center[c] + q);
+				__m128 x = _mm_loadu_ps(t.AxisX[c] + q);
+				__m128 y = _mm_loadu_ps(t.AxisY[c] + q);
+				__m128 s = _mm_add_ps(x, y);
+				__m128 d = _mm_sub_ps(x, y);
+				_mm_store_ps(corners[0][c], _mm_sub_ps(center, s));
+				_mm_store_ps(corners[1][c], _mm_add_ps(center, d));
+				_mm_store_ps(corners[2][c], _mm_add_ps(center, s));
+				_mm_store_ps(corners[3][c], _mm_sub_ps(center, d));
+			}
+			ScatterCorners(corners, vertices + (size_t)q * 4 * vertexStride, vertexStride);
+		}
+		return q;
+	}
+
+	EG_TARGET_AVX2 static uint32_t TransformQuadsAVX2(const QuadStreams& t, uint32_t begin, uint32_t end, uint8_t* vertices, uint32_t vertexStride)
+	{
+		alignas(32) float corners[4][3][8];
+
+		uint32_t q = begin;
+		for (; q + 8 <= end; q += 8)
+		{
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				__m256 center = _mm256_loadu_ps(t.Center[c] + q);
+				__m256 x = _mm256_loadu_ps(t.AxisX[c] + q);
+				__m256 y = _mm256_loadu_ps(t.AxisY[c] + q);
+				__m256 s = _mm256_add_ps(x, y);
+				__m256 d = _mm256_sub_ps(x, y);
+				_mm256_store_ps(corners[0][c], _mm256_sub_ps(center, s));
+				_mm256_store_ps(corners[1][c], _mm256_add_ps(center, d));
+				_mm256_store_ps(corners[2][c], _mm256_add_ps(center, s));
+				_mm256_store_ps(corners[3][c], _mm256_sub_ps(center, d));
+			}
+			ScatterCorners(corners, vertices + (size_t)q * 4 * vertexStride, vertexStride);
+		}
+		return q;
+	}
+#endif
+
+	void TransformQuads(const QuadTransformArray& transforms, uint32_t first, uint32_t count, void* vertices, uint32_t vertexStride)
+	{
+		EG_CORE_ASSERT(first + count <= transforms.GetCapacity(), "Quad transform range out of bounds!");
+
+		QuadStreams t = {
+			{ transforms.CenterX + first, transforms.CenterY + first, transforms.CenterZ + first },
+			{ transforms.AxisXx + first, transforms.AxisXy + first, transforms.AxisXz + first },
+			{ transforms.AxisYx + first, transforms.AxisYy + first, transforms.AxisYz + first },
+		};
+
+		uint8_t* base = (uint8_t*)vertices;
+		uint32_t q = 0;
+#ifdef EG_SIMD_X86
+		if (SIMD::HasAVX2())
+			q = TransformQuadsAVX2(t, q, count, base, vertexStride);
+		q = TransformQuadsSSE(t, q, count, base, vertexStride);
+#endif
+		TransformQuadsScalar(t, q, count, base, vertexStride);
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <glm/glm.hpp>
+
+namespace Engine
+{
+	// Structure-of-arrays placement for a run of unit quads. Each quad is stored as its center
+	// plus half of its two edge vectors, so the corners are
+	// center - x - y, center + x - y, center + x + y, center - x + y.
+	class QuadTransformArray
+	{
+	public:
+		QuadTransformArray() = default;
+		QuadTransformArray(const QuadTransformArray&) = delete;
+		QuadTransformArray& operator=(const QuadTransformArray&) = delete;
+		~QuadTransformArray();
+
+		void Reserve(uint32_t capacity);
+		uint32_t GetCapacity() const { return m_Capacity; }
+
+		void Set(uint32_t index, const QuadTransformArray& other, uint32_t otherIndex)
+		{
+			CenterX[index] = other.CenterX[otherIndex]; CenterY[index] = other.CenterY[otherIndex]; CenterZ[index] = other.CenterZ[otherIndex];
+			AxisXx[index] = other.AxisXx[otherIndex]; AxisXy[index] = other.AxisXy[otherIndex]; AxisXz[index] = other.AxisXz[otherIndex];
+			AxisYx[index] = other.AxisYx[otherIndex]; AxisYy[index] = other.AxisYy[otherIndex]; AxisYz[index] = other.AxisYz[otherIndex];
+		}
+
+		void Set(uint32_t index, const glm::vec3& center, const glm::vec3& halfAxisX, const glm::vec3& halfAxisY)
+		{
+			CenterX[index] = center.x; CenterY[index] = center.y; CenterZ[index] = center.z;
+			AxisXx[index] = halfAxisX.x; AxisXy[index] = halfAxisX.y; AxisXz[index] = halfAxisX.z;
+			AxisYx[index] = halfAxisY.x; AxisYy[index] = halfAxisY.y; AxisYz[index] = halfAxisY.z;
+		}
+	public:
+		float* CenterX = nullptr;
+		float* CenterY = nullptr;
+		float* CenterZ = nullptr;
+		float* AxisXx = nullptr;
+		float* AxisXy = nullptr;
+		float* AxisXz = nullptr;
+		float* AxisYx = nullptr;
+		float* AxisYy = nullptr;
+		float* AxisYz = nullptr;
+	private:
+		uint32_t m_Capacity = 0;
+		float* m_Memory = nullptr;
+	};
+
+	// Writes the four corner positions of quads [first, first + count) into a vertex array whose
+	// vertices start with a glm::vec3 position and are vertexStride bytes apart. Several quads are
+	// processed per iteration with AVX2 or SSE depending on the CPU.
+	void TransformQuads(const QuadTransformArray& transforms, uint32_t first, uint32_t count, void* vertices, uint32_t vertexStride);
+}
@@ -2,7 +2,16 @@
 #include "RenderCommand.h"
 #include "Platform/OpenGL/OpenGLRendererAPI.h"
 
+#include <cstdlib>
+
 namespace Engine
 {
 	RendererAPI* RenderCommand::s_RendererAPI = new OpenGLRendererAPI();
+	thread_local RenderCommandQueue* RenderCommand::s_RecordingQueue = nullptr;
+
+	void RenderCommand::ContextMissing(const char* caller)
+	{
+		EG_CORE_ERROR("{0} calls the graphics API directly and cannot be used while recording for the render thread!", caller);
+		std::abort();
+	}
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "RendererAPI.h"
+#include "RenderCommandQueue.h"
 
 namespace Engine
 {
@@ -11,25 +12,162 @@ namespace Engine
 			s_RendererAPI->Init();
 		}
 
+		// While a queue is set, commands from the calling thread are recorded into it rather than issued, see
+		// RenderThread. Other threads, such as the render thread running Submit callbacks, still issue them.
+		static void SetRecordingQueue(RenderCommandQueue* queue) { s_RecordingQueue = queue; }
+		static bool IsRecording() { return s_RecordingQueue != nullptr; }
+		// For code calling the graphics API itself: the recording thread has no context, so getting there
+		// logs who did and aborts, in every build
+		static void RequireContext(const char* caller)
+		{
+			if (s_RecordingQueue)
+				ContextMissing(caller);
+		}
+		// Replays recorded commands; only on the thread owning the graphics context
+		static void Execute(const RenderCommandQueue& queue)
+		{
+			s_RendererAPI->Execute(queue);
+		}
+
 		static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 		{
-			s_RendererAPI->SetViewport(x, y, width, height);
+			if (s_RecordingQueue)
+				*s_RecordingQueue->Allocate<RenderCommands::SetViewport>(RenderCommandType::SetViewport) = { x, y, width, height };
+			else
+				s_RendererAPI->SetViewport(x, y, width, height);
 		}
 		static void SetClearColor(const glm::vec4& color)
 		{
-			s_RendererAPI->SetClearColor(color);
+			if (s_RecordingQueue)
+				s_RecordingQueue->Allocate<RenderCommands::SetClearColor>(RenderCommandType::SetClearColor)->Color = color;
+			else
+				s_RendererAPI->SetClearColor(color);
 		}
 		static void Clear()
 		{
-			s_RendererAPI->Clear();
+			if (s_RecordingQueue)
+				s_RecordingQueue->Allocate<RenderCommands::Clear>(RenderCommandType::Clear);
+			else
+				s_RendererAPI->Clear();
 		}
 
-		static void DrawIndexed(const Ref<VertexArray>& vertexArray)
+		static void SetBlendMode(BlendMode mode)
+		{
+			if (s_RecordingQueue)
+				s_RecordingQueue->Allocate<RenderCommands::SetBlendMode>(RenderCommandType::SetBlendMode)->Mode = mode;
+			else
+				s_RendererAPI->SetBlendMode(mode);
+		}
+		static void SetDepthTest(bool enabled)
+		{
+			if (s_RecordingQueue)
+				s_RecordingQueue->Allocate<RenderCommands::SetEnabled>(RenderCommandType::SetDepthTest)->Enabled = enabled;
+			else
+				s_RendererAPI->SetDepthTest(enabled);
+		}
+		static void SetDepthWrite(bool enabled)
+		{
+			if (s_RecordingQueue)
+				s_RecordingQueue->Allocate<RenderCommands::SetEnabled>(RenderCommandType::SetDepthWrite)->Enabled = enabled;
+			else
+				s_RendererAPI->SetDepthWrite(enabled);
+		}
+
+		static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t baseVertex = 0)
+		{
+			if (s_RecordingQueue)
+			{
+				*s_RecordingQueue->Allocate<RenderCommands::DrawIndexed>(RenderCommandType::DrawIndexed) = { vertexArray.get(), indexCount, baseVertex };
+				s_RecordingQueue->Retain(vertexArray);
+			}
+			else
+				s_RendererAPI->DrawIndexed(vertexArray, indexCount, baseVertex);
+		}
+		static void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount = 0, uint32_t baseInstance = 0)
+		{
+			if (s_RecordingQueue)
+			{
+				*s_RecordingQueue->Allocate<RenderCommands::DrawIndexedInstanced>(RenderCommandType::DrawIndexedInstanced) = { vertexArray.get(), instanceCount, indexCount, baseInstance };
+				s_RecordingQueue->Retain(vertexArray);
+			}
+			else
+				s_RendererAPI->DrawIndexedInstanced(vertexArray, instanceCount, indexCount, baseInstance);
+		}
+
+		static void DrawArraysIndirect(const Ref<VertexArray>& vertexArray, const Ref<IndirectBuffer>& indirectBuffer, uint32_t offset = 0)
+		{
+			if (s_RecordingQueue)
+				RecordIndirect(RenderCommandType::DrawArraysIndirect, vertexArray, indirectBuffer, 1, offset);
+			else
+				s_RendererAPI->DrawArraysIndirect(vertexArray, indirectBuffer, offset);
+		}
+
+		static void MultiDrawIndexedIndirect(const Ref<VertexArray>& vertexArray, const Ref<IndirectBuffer>& indirectBuffer, uint32_t drawCount, uint32_t offset = 0)
+		{
+			if (s_RecordingQueue)
+				RecordIndirect(RenderCommandType::MultiDrawIndexedIndirect, vertexArray, indirectBuffer, drawCount, offset);
+			else
+				s_RendererAPI->MultiDrawIndexedIndirect(vertexArray, indirectBuffer, drawCount, offset);
+		}
+
+		static void DispatchCompute(uint32_t groupsX, uint32_t groupsY = 1, uint32_t groupsZ = 1)
+		{
+			if (s_RecordingQueue)
+				*s_RecordingQueue->Allocate<RenderCommands::DispatchCompute>(RenderCommandType::DispatchCompute) = { groupsX, groupsY, groupsZ };
+			else
+				s_RendererAPI->DispatchCompute(groupsX, groupsY, groupsZ);
+		}
+		// Makes shader writes so far visible to the kinds of reads in barriers (MemoryBarrierBits)
+		static void InsertMemoryBarrier(uint32_t barriers)
+		{
+			if (s_RecordingQueue)
+				s_RecordingQueue->Allocate<RenderCommands::InsertMemoryBarrier>(RenderCommandType::InsertMemoryBarrier)->Barriers = barriers;
+			else
+				s_RendererAPI->InsertMemoryBarrier(barriers);
+		}
+
+		// Runs fn(data) where GPU work happens: right away, or on the render thread while recording.
+		// Code calling the graphics API outside RenderCommand goes through here to work with a render thread.
+		template<typename T>
+		static void Submit(void (*fn)(const T&), const T& data)
+		{
+			if (s_RecordingQueue)
+				s_RecordingQueue->Submit(fn, data);
+			else
+				fn(data);
+		}
+		// Keeps a resource a Submit callback uses through a raw pointer alive until the callback has run
+		static void Retain(std::shared_ptr<const void> resource)
+		{
+			if (s_RecordingQueue)
+				s_RecordingQueue->Retain(std::move(resource));
+		}
+
+		// Queried once at start up, before any render thread takes the context
+		static uint32_t GetMaxTextureSlots()
+		{
+			return s_RendererAPI->GetMaxTextureSlots();
+		}
+
+		static RendererAPI::StateCacheStatistics GetStateCacheStats()
+		{
+			return s_RendererAPI->GetStateCacheStats();
+		}
+		static void ResetStateCacheStats()
+		{
+			s_RendererAPI->ResetStateCacheStats();
+		}
+	private:
+		static void RecordIndirect(RenderCommandType type, const Ref<VertexArray>& vertexArray, const Ref<IndirectBuffer>& indirectBuffer, uint32_t drawCount, uint32_t offset)
 		{
-			s_RendererAPI->DrawIndexed(vertexArray);
+			*s_RecordingQueue->Allocate<RenderCommands::DrawIndirect>(type) = { vertexArray.get(), indirectBuffer.get(), drawCount, offset };
+			s_RecordingQueue->Retain(vertexArray);
+			s_RecordingQueue->Retain(indirectBuffer);
 		}
+		[[noreturn]] static void ContextMissing(const char* caller);
 	private:
 		static RendererAPI* s_RendererAPI;
+		static thread_local RenderCommandQueue* s_RecordingQueue;
 	};
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,45 @@
+#include "engine_pch.h"
+#include "RenderCommandQueue.h"
+
+#include "Engine/Core/SIMD.h"
+
+namespace Engine
+{
+	RenderCommandQueue::RenderCommandQueue(uint32_t initialSize)
+	{
+		m_Capacity = AlignSize(std::max(initialSize, 1024u));
+		m_Buffer = (uint8_t*)SIMD::AlignedAlloc(m_Capacity, alignof(RenderCommandHeader));
+	}
+
+	RenderCommandQueue::~RenderCommandQueue()
+	{
+		SIMD::AlignedFree(m_Buffer);
+	}
+
+	uint8_t* RenderCommandQueue::Reserve(uint32_t size)
+	{
+		if (m_Size + size > m_Capacity)
+		{
+			uint32_t capacity = m_Capacity * 2;
+			while (m_Size + size > capacity)
+				capacity *= 2;
+
+			// Records are plain data, so they move with a copy
+			uint8_t* buffer = (uint8_t*)SIMD::AlignedAlloc(capacity, alignof(RenderCommandHeader));
+			memcpy(buffer, m_Buffer, m_Size);
+			SIMD::AlignedFree(m_Buffer);
+			m_Buffer = buffer;
+			m_Capacity = capacity;
+		}
+
+		uint8_t* record = m_Buffer + m_Size;
+		m_Size += size;
+		return record;
+	}
+
+	void RenderCommandQueue::Reset()
+	{
+		m_Size = 0;
+		m_Resources.clear();
+	}
+}
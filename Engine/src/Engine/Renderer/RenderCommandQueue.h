@@ -0,0 +1,104 @@
+#pragma once
+#include "RendererAPI.h"
+
+namespace Engine
+{
+	enum class RenderCommandType : uint8_t
+	{
+		SetViewport = 0, SetClearColor, Clear, SetBlendMode, SetDepthTest, SetDepthWrite,
+		DrawIndexed, DrawIndexedInstanced, DrawArraysIndirect, MultiDrawIndexedIndirect,
+		DispatchCompute, InsertMemoryBarrier, Callback
+	};
+
+	// Precedes every record; Size covers the header and the payload, so records can be skipped without decoding
+	struct alignas(16) RenderCommandHeader
+	{
+		RenderCommandType Type;
+		uint32_t Size;
+	};
+
+	// Payloads of the recorded commands. They only hold plain data; resources are referenced by raw pointer
+	// and kept alive by the queue until it is reset.
+	namespace RenderCommands
+	{
+		struct SetViewport { uint32_t X, Y, Width, Height; };
+		struct SetClearColor { glm::vec4 Color; };
+		struct Clear {};
+		struct SetBlendMode { BlendMode Mode; };
+		struct SetEnabled { bool Enabled; };
+		struct DrawIndexed { VertexArray* Geometry; uint32_t IndexCount; uint32_t BaseVertex; };
+		struct DrawIndexedInstanced { VertexArray* Geometry; uint32_t InstanceCount; uint32_t IndexCount; uint32_t BaseInstance; };
+		struct DrawIndirect { VertexArray* Geometry; IndirectBuffer* Commands; uint32_t DrawCount; uint32_t Offset; };
+		struct DispatchCompute { uint32_t GroupsX, GroupsY, GroupsZ; };
+		struct InsertMemoryBarrier { uint32_t Barriers; };
+		// A Callback payload starts with a void (*)(const void* payload) that runs it, see RenderCommandQueue::Submit
+	}
+
+	// Commands recorded by RenderCommand while a render thread owns the graphics context, see RenderThread.
+	// Records are bump allocated from one block that keeps its size across frames, so recording a frame
+	// allocates nothing once the queue has grown to the largest frame.
+	class RenderCommandQueue
+	{
+	public:
+		RenderCommandQueue(uint32_t initialSize = 64 * 1024);
+		~RenderCommandQueue();
+
+		RenderCommandQueue(const RenderCommandQueue&) = delete;
+		RenderCommandQueue& operator=(const RenderCommandQueue&) = delete;
+
+		template<typename T>
+		T* Allocate(RenderCommandType type)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Render commands must be plain data!");
+			uint32_t size = AlignSize(sizeof(RenderCommandHeader) + sizeof(T));
+			uint8_t* record = Reserve(size);
+			RenderCommandHeader* header = new (record) RenderCommandHeader;
+			header->Type = type;
+			header->Size = size;
+			return new (record + sizeof(RenderCommandHeader)) T;
+		}
+
+		// Keeps a resource referenced by a record alive until the queue has been replayed
+		void Retain(std::shared_ptr<const void> resource) { m_Resources.push_back(std::move(resource)); }
+
+		// Records fn(data) to run on the replaying thread; data is copied into the queue
+		template<typename T>
+		void Submit(void (*fn)(const T&), const T& data)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Render command data must be plain data!");
+			CallbackRecord<T>* record = Allocate<CallbackRecord<T>>(RenderCommandType::Callback);
+			record->Invoke = &CallbackRecord<T>::Run;
+			record->Function = fn;
+			record->Data = data;
+		}
+
+		const uint8_t* GetData() const { return m_Buffer; }
+		uint32_t GetSize() const { return m_Size; }
+		bool IsEmpty() const { return m_Size == 0; }
+
+		// Drops the records and the retained resources, keeping the memory
+		void Reset();
+	private:
+		template<typename T>
+		struct CallbackRecord
+		{
+			void (*Invoke)(const void* record);
+			void (*Function)(const T&);
+			T Data;
+
+			static void Run(const void* record)
+			{
+				const CallbackRecord* self = (const CallbackRecord*)record;
+				self->Function(self->Data);
+			}
+		};
+
+		static uint32_t AlignSize(uint32_t size) { return (size + alignof(RenderCommandHeader) - 1) & ~(uint32_t)(alignof(RenderCommandHeader) - 1); }
+		uint8_t* Reserve(uint32_t size);
+	private:
+		uint8_t* m_Buffer = nullptr;
+		uint32_t m_Capacity = 0;
+		uint32_t m_Size = 0;
+		std::vector<std::shared_ptr<const void>> m_Resources;
+	};
+}
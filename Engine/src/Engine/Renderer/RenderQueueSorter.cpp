@@ -0,0 +1,113 @@
+#include "engine_pch.h"
+#include "RenderQueueSorter.h"
+
+namespace Engine
+{
+	// More out-of-place elements than this and the previous order is not worth repairing
+	static const uint32_t MaxRepairFraction = 16;
+
+	const uint32_t* RenderQueueSorter::Sort(const uint64_t* keys, uint32_t count)
+	{
+		if (!TryReuseOrder(keys, count))
+			RadixSort(keys, count);
+		return m_Order.data();
+	}
+
+	bool RenderQueueSorter::TryReuseOrder(const uint64_t* keys, uint32_t count)
+	{
+		if (count == 0 || m_Order.size() != count)
+			return false;
+
+		// Submission i sorts before j when its key is smaller, or equal with i < j
+		auto less = [keys](uint32_t i, uint32_t j) { return keys[i] < keys[j] || (keys[i] == keys[j] && i < j); };
+
+		uint32_t descents = 0;
+		for (uint32_t i = 1; i < count; i++)
+		{
+			if (less(m_Order[i], m_Order[i - 1]))
+				descents++;
+		}
+
+		if (descents == 0)
+		{
+			m_Stats.CoherentFrames++;
+			return true;
+		}
+		if (descents > count / MaxRepairFraction)
+			return false;
+
+		// Few elements moved since last frame; insertion sort costs O(n + moved distance)
+		for (uint32_t i = 1; i < count; i++)
+		{
+			uint32_t value = m_Order[i];
+			uint32_t j = i;
+			while (j > 0 && less(value, m_Order[j - 1]))
+			{
+				m_Order[j] = m_Order[j - 1];
+				j--;
+			}
+			m_Order[j] = value;
+		}
+		m_Stats.InsertionSorts++;
+		return true;
+	}
+
+	void RenderQueueSorter::RadixSort(const uint64_t* keys, uint32_t count)
+	{
+		m_Order.resize(count);
+		m_Scratch.resize(count);
+		m_Keys.assign(keys, keys + count);
+		m_KeyScratch.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+			m_Order[i] = i;
+
+		if (count < 2)
+			return;
+
+		// Histograms for all eight byte passes are built in a single read of the keys
+		uint32_t histograms[8][256] = {};
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint64_t key = keys[i];
+			for (uint32_t pass = 0; pass < 8; pass++)
+				histograms[pass][(key >> (pass * 8)) & 0xff]++;
+		}
+
+		uint32_t* order = m_Order.data();
+		uint32_t* orderScratch = m_Scratch.data();
+		uint64_t* sortKeys = m_Keys.data();
+		uint64_t* keyScratch = m_KeyScratch.data();
+
+		for (uint32_t pass = 0; pass < 8; pass++)
+		{
+			uint32_t* histogram = histograms[pass];
+			uint32_t shift = pass * 8;
+
+			// Every key has the same byte here, the pass would not move anything
+			if (histogram[(sortKeys[0] >> shift) & 0xff] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (uint32_t b = 0; b < 256; b++)
+			{
+				uint32_t bucketCount = histogram[b];
+				histogram[b] = offset;
+				offset += bucketCount;
+			}
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				uint32_t destination = histogram[(sortKeys[i] >> shift) & 0xff]++;
+				keyScratch[destination] = sortKeys[i];
+				orderScratch[destination] = order[i];
+			}
+
+			std::swap(sortKeys, keyScratch);
+			std::swap(order, orderScratch);
+		}
+
+		if (order != m_Order.data())
+			memcpy(m_Order.data(), order, sizeof(uint32_t) * count);
+		m_Stats.RadixSorts++;
+	}
+}
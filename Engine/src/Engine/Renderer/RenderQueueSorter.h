@@ -0,0 +1,35 @@
+#pragma once
+
+namespace Engine
+{
+	// Orders draw submissions by their 64-bit sort keys. The sort is stable, so submissions with
+	// equal keys keep their submission order.
+	//
+	// The order of the previous call is kept and tried first: when the submission count is unchanged
+	// and the keys are still (almost) in that order, the result is repaired with an insertion sort
+	// instead of running a full LSD radix sort.
+	class RenderQueueSorter
+	{
+	public:
+		// Returns submission indices in draw order, valid until the next call
+		const uint32_t* Sort(const uint64_t* keys, uint32_t count);
+
+		struct Statistics
+		{
+			uint32_t CoherentFrames = 0;
+			uint32_t InsertionSorts = 0;
+			uint32_t RadixSorts = 0;
+		};
+		const Statistics& GetStats() const { return m_Stats; }
+		void ResetStats() { m_Stats = Statistics(); }
+	private:
+		bool TryReuseOrder(const uint64_t* keys, uint32_t count);
+		void RadixSort(const uint64_t* keys, uint32_t count);
+	private:
+		std::vector<uint32_t> m_Order;
+		std::vector<uint32_t> m_Scratch;
+		std::vector<uint64_t> m_Keys;
+		std::vector<uint64_t> m_KeyScratch;
+		Statistics m_Stats;
+	};
+}
@@ -0,0 +1,131 @@
+#include "engine_pch.h"
+#include "RenderThread.h"
+
+#include "RenderCommand.h"
+#include "GraphicsContext.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace Engine
+{
+	struct RenderThreadData
+	{
+		GraphicsContext* context = nullptr;
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable frameQueued;
+		std::condition_variable frameReplayed;
+		bool running = false;
+
+		// A ring of framesInFlight + 1 queues: one being recorded and up to framesInFlight queued.
+		// Queued frames are replayed in order from replayIndex; a frame counts as queued until its
+		// replay has finished, so recordIndex never reaches a queue the render thread is reading.
+		std::vector<Scope<RenderCommandQueue>> queues;
+		uint32_t framesInFlight = 1;
+		uint32_t recordIndex = 0;
+		uint32_t replayIndex = 0;
+		uint32_t queuedFrames = 0;
+	};
+
+	static RenderThreadData* s_renderThread = nullptr;
+
+	static void RenderThreadMain()
+	{
+		s_renderThread->context->MakeCurrent();
+		while (true)
+		{
+			RenderCommandQueue* queue;
+			{
+				std::unique_lock<std::mutex> lock(s_renderThread->mutex);
+				s_renderThread->frameQueued.wait(lock, [] { return s_renderThread->queuedFrames > 0 || !s_renderThread->running; });
+				if (s_renderThread->queuedFrames == 0)
+					break;
+				queue = s_renderThread->queues[s_renderThread->replayIndex].get();
+			}
+
+			RenderCommand::Execute(*queue);
+			s_renderThread->context->SwapBuffers();
+			queue->Reset();
+
+			{
+				std::lock_guard<std::mutex> lock(s_renderThread->mutex);
+				s_renderThread->replayIndex = (s_renderThread->replayIndex + 1) % (uint32_t)s_renderThread->queues.size();
+				s_renderThread->queuedFrames--;
+			}
+			s_renderThread->frameReplayed.notify_all();
+		}
+		s_renderThread->context->ReleaseCurrent();
+	}
+
+	void RenderThread::Start(GraphicsContext* context, uint32_t framesInFlight)
+	{
+		EG_CORE_ASSERT(!s_renderThread, "Render thread already running!");
+		EG_CORE_ASSERT(framesInFlight > 0, "At least one frame must be in flight!");
+
+		s_renderThread = new RenderThreadData;
+		s_renderThread->context = context;
+		s_renderThread->framesInFlight = framesInFlight;
+		for (uint32_t i = 0; i <= framesInFlight; i++)
+			s_renderThread->queues.emplace_back(new RenderCommandQueue());
+		s_renderThread->running = true;
+
+		context->ReleaseCurrent();
+		s_renderThread->thread = std::thread(RenderThreadMain);
+	}
+
+	void RenderThread::Stop()
+	{
+		if (!s_renderThread)
+			return;
+
+		EG_CORE_ASSERT(!RenderCommand::IsRecording(), "Render thread stopped in the middle of a frame!");
+		{
+			std::lock_guard<std::mutex> lock(s_renderThread->mutex);
+			s_renderThread->running = false;
+		}
+		s_renderThread->frameQueued.notify_one();
+		s_renderThread->thread.join();
+
+		s_renderThread->context->MakeCurrent();
+		delete s_renderThread;
+		s_renderThread = nullptr;
+	}
+
+	bool RenderThread::IsRunning()
+	{
+		return s_renderThread != nullptr;
+	}
+
+	void RenderThread::BeginFrame()
+	{
+		{
+			std::unique_lock<std::mutex> lock(s_renderThread->mutex);
+			s_renderThread->frameReplayed.wait(lock, [] { return s_renderThread->queuedFrames < s_renderThread->framesInFlight; });
+		}
+		RenderCommand::SetRecordingQueue(s_renderThread->queues[s_renderThread->recordIndex].get());
+	}
+
+	void RenderThread::EndFrame()
+	{
+		RenderCommand::SetRecordingQueue(nullptr);
+		{
+			std::lock_guard<std::mutex> lock(s_renderThread->mutex);
+			s_renderThread->recordIndex = (s_renderThread->recordIndex + 1) % (uint32_t)s_renderThread->queues.size();
+			s_renderThread->queuedFrames++;
+		}
+		s_renderThread->frameQueued.notify_one();
+	}
+
+	void RenderThread::Flush()
+	{
+		std::unique_lock<std::mutex> lock(s_renderThread->mutex);
+		s_renderThread->frameReplayed.wait(lock, [] { return s_renderThread->queuedFrames == 0; });
+	}
+
+	uint32_t RenderThread::GetFramesInFlight()
+	{
+		return s_renderThread ? s_renderThread->framesInFlight : 0;
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "RenderCommandQueue.h"
+
+namespace Engine
+{
+	class GraphicsContext;
+
+	// Replays frames recorded through RenderCommand on a thread that owns the graphics context, so the
+	// main thread can record the next frame while the driver works through the previous one.
+	//
+	// While it runs, the main thread has no context: GPU work must go through RenderCommand, with
+	// RenderCommand::Submit for anything RenderCommand does not cover; Submit functions run on the render
+	// thread and may use the graphics API freely. Renderer's SetSceneCamera, Submit and SubmitInstanced
+	// record as well. Renderer2D, Tilemap, the particle systems, queued meshes, UniformHandle and the
+	// creation of resources call the graphics API themselves and abort when reached while recording, in
+	// every build. Resources created before Start may be used freely.
+	class RenderThread
+	{
+	public:
+		// Takes the context from the calling thread. framesInFlight bounds how many recorded frames may
+		// wait for or be in replay while the next one is recorded.
+		static void Start(GraphicsContext* context, uint32_t framesInFlight = 1);
+		// Replays the frames still queued and hands the context back to the calling thread
+		static void Stop();
+		static bool IsRunning();
+
+		// Waits for a free frame and starts recording into it
+		static void BeginFrame();
+		// Stops recording and queues the frame; the render thread replays it and presents
+		static void EndFrame();
+		// Blocks until every queued frame has been replayed
+		static void Flush();
+
+		static uint32_t GetFramesInFlight();
+	};
+}
@@ -1,19 +1,67 @@
 #include "engine_pch.h"
 #include "Renderer.h"
 #include "Renderer2D.h"
+#include "MeshBuffer.h"
 #include <Engine/Renderer/Shader.h>
-#include <Platform/OpenGL/OpenGLShader.h>
 
 namespace Engine
 {
+    // Storage block binding of the model matrices in mesh shaders
+    static const uint32_t DrawDataBinding = 0;
+    static CachedUniform<int> s_DrawOffsetUniform("u_DrawOffset"_sid);
+    static CachedUniform<glm::mat4> s_ModelMatUniform("modelMat"_sid);
+
+    struct MeshSubmission
+    {
+        Ref<Shader> MeshShader;
+        Ref<MeshBuffer> Meshes;
+        uint32_t Mesh;
+        glm::mat4 Transform;
+    };
+
+    struct MeshQueueStorage
+    {
+        std::vector<MeshSubmission> Submissions;
+
+        // Staging for one upload of all commands and model matrices per scene
+        std::vector<DrawElementsIndirectCommand> Commands;
+        std::vector<glm::mat4> Transforms;
+
+        // Sized in draws, grown by doubling
+        uint32_t Capacity = 0;
+        Ref<IndirectBuffer> CommandBuffer;
+        Ref<ShaderStorageBuffer> DrawDataBuffer;
+
+        Renderer::Statistics Stats;
+    };
+
+    static MeshQueueStorage* s_MeshQueue;
+    static Scope<UniformBuffer> s_SceneUniformBuffer;
+
     Renderer::SceneData* Renderer::m_SceneData = new Renderer::SceneData;
 
     void Renderer::Init()
     {
         RenderCommand::Init();
+
+        s_MeshQueue = new MeshQueueStorage;
+
+        m_SceneData->ViewProjectionMat = glm::mat4(1.f);
+        s_SceneUniformBuffer.reset(UniformBuffer::Create(sizeof(SceneData), m_SceneData));
+
+        // Renderer2D sets the scene camera, so it starts after the scene buffer exists
         Renderer2D::Init();
     }
 
+    void Renderer::ShutDown()
+    {
+        Renderer2D::ShutDown();
+
+        s_SceneUniformBuffer.reset();
+        delete s_MeshQueue;
+        s_MeshQueue = nullptr;
+    }
+
     void Renderer::OnWindowResize(uint32_t width, uint32_t height)
     {
         RenderCommand::SetViewport(0, 0, width, height);
@@ -21,20 +69,132 @@ namespace Engine
 
     void Renderer::BeginScene(const OrthographicCamera& camera)
     {
-        m_SceneData->ViewProjectionMat = camera.GetViewProjectionMatrix();
+        SetSceneCamera(camera);
+    }
+
+    void Renderer::SetSceneCamera(const OrthographicCamera& camera)
+    {
+        RenderCommand::Submit(UploadSceneCamera, camera.GetViewProjectionMatrix());
+    }
+
+    void Renderer::UploadSceneCamera(const glm::mat4& viewProjection)
+    {
+        s_SceneUniformBuffer->BindBase(Shader::SceneDataBinding);
+
+        if (m_SceneData->ViewProjectionMat == viewProjection)
+            return;
+
+        m_SceneData->ViewProjectionMat = viewProjection;
+        s_SceneUniformBuffer->SetData(m_SceneData, sizeof(SceneData));
     }
 
     void Renderer::EndScene()
     {
+        auto& submissions = s_MeshQueue->Submissions;
+        uint32_t drawCount = (uint32_t)submissions.size();
+        if (!drawCount)
+            return;
+        RenderCommand::RequireContext("Renderer::EndScene");
+
+        // Group by shader and mesh buffer; stable, so meshes within a group keep their submission order
+        std::stable_sort(submissions.begin(), submissions.end(), [](const MeshSubmission& a, const MeshSubmission& b)
+            {
+                if (a.MeshShader != b.MeshShader)
+                    return a.MeshShader < b.MeshShader;
+                return a.Meshes < b.Meshes;
+            });
+
+        auto& commands = s_MeshQueue->Commands;
+        auto& transforms = s_MeshQueue->Transforms;
+        commands.resize(drawCount);
+        transforms.resize(drawCount);
+        for (uint32_t i = 0; i < drawCount; i++)
+        {
+            const MeshBuffer::Mesh& mesh = submissions[i].Meshes->GetMesh(submissions[i].Mesh);
+            commands[i] = { mesh.IndexCount, 1, mesh.FirstIndex, (int32_t)mesh.BaseVertex, 0 };
+            transforms[i] = submissions[i].Transform;
+        }
+
+        if (drawCount > s_MeshQueue->Capacity)
+        {
+            uint32_t capacity = std::max(s_MeshQueue->Capacity, 256u);
+            while (capacity < drawCount)
+                capacity *= 2;
+            s_MeshQueue->Capacity = capacity;
+            s_MeshQueue->CommandBuffer.reset(IndirectBuffer::Create(capacity * sizeof(DrawElementsIndirectCommand)));
+            s_MeshQueue->DrawDataBuffer.reset(ShaderStorageBuffer::Create(capacity * sizeof(glm::mat4)));
+        }
+        s_MeshQueue->CommandBuffer->SetData(commands.data(), drawCount * sizeof(DrawElementsIndirectCommand));
+        s_MeshQueue->DrawDataBuffer->SetData(transforms.data(), drawCount * sizeof(glm::mat4));
+        s_MeshQueue->DrawDataBuffer->BindBase(DrawDataBinding);
+
+        uint32_t groupStart = 0;
+        while (groupStart < drawCount)
+        {
+            const MeshSubmission& first = submissions[groupStart];
+            uint32_t groupEnd = groupStart + 1;
+            while (groupEnd < drawCount && submissions[groupEnd].MeshShader == first.MeshShader && submissions[groupEnd].Meshes == first.Meshes)
+                groupEnd++;
+
+            // gl_DrawID restarts at zero for every multi-draw, u_DrawOffset locates the group's matrices
+            first.MeshShader->Bind();
+            s_DrawOffsetUniform.Set(first.MeshShader, (int)groupStart);
+            first.Meshes->GetVertexArray()->ValidateLayout(*first.MeshShader);
+            RenderCommand::MultiDrawIndexedIndirect(first.Meshes->GetVertexArray(), s_MeshQueue->CommandBuffer, groupEnd - groupStart, groupStart * sizeof(DrawElementsIndirectCommand));
+            s_MeshQueue->Stats.DrawCalls++;
+
+            groupStart = groupEnd;
+        }
+
+        s_MeshQueue->Stats.MeshCount += drawCount;
+        submissions.clear();
+    }
+
+    // Binding runs where the draw does, the draw itself is recorded after it and keeps the vertex array alive
+    struct DrawSetup
+    {
+        VertexArray* Geometry;
+        const Shader* DrawShader;
+        glm::mat4 Transform;
+        bool SetTransform;
+    };
+
+    static void SetUpDraw(const DrawSetup& setup)
+    {
+        setup.DrawShader->Bind();
+        if (setup.SetTransform)
+            s_ModelMatUniform.Set(*setup.DrawShader, setup.Transform);
+
+        setup.Geometry->Bind();
+        setup.Geometry->ValidateLayout(*setup.DrawShader);
     }
 
     void Renderer::Submit(const Ref<VertexArray>& vertexArray, const Ref<Shader>& shader, const glm::mat4& transform)
     {
-        std::dynamic_pointer_cast<OpenGLShader> (shader)->use();
-        std::dynamic_pointer_cast<OpenGLShader> (shader)->setMat4fv("modelMat", transform);
-        std::dynamic_pointer_cast<OpenGLShader> (shader)->setMat4fv("viewProjMat", m_SceneData->ViewProjectionMat);
-
-        vertexArray->Bind();
+        RenderCommand::Retain(shader);
+        RenderCommand::Submit(SetUpDraw, { vertexArray.get(), shader.get(), transform, true });
         RenderCommand::DrawIndexed(vertexArray);
     }
+
+    void Renderer::SubmitInstanced(const Ref<VertexArray>& vertexArray, const Ref<Shader>& shader, uint32_t instanceCount)
+    {
+        RenderCommand::Retain(shader);
+        RenderCommand::Submit(SetUpDraw, { vertexArray.get(), shader.get(), glm::mat4(1.f), false });
+        RenderCommand::DrawIndexedInstanced(vertexArray, instanceCount);
+    }
+
+    void Renderer::Submit(const Ref<MeshBuffer>& meshBuffer, uint32_t mesh, const Ref<Shader>& shader, const glm::mat4& transform)
+    {
+        s_MeshQueue->Submissions.push_back({ shader, meshBuffer, mesh, transform });
+    }
+
+    Renderer::Statistics Renderer::GetStats()
+    {
+        return s_MeshQueue->Stats;
+    }
+
+    void Renderer::ResetStats()
+    {
+        memset(&s_MeshQueue->Stats, 0, sizeof(Statistics));
+    }
 }
\ No newline at end of file
@@ -6,26 +6,51 @@
 namespace Engine
 {
 	class Shader;
+	class MeshBuffer;
 
 	class Renderer
 	{
 	public:
 		static void Init();
+		// Needs the graphics context, so it runs before the window goes away
+		static void ShutDown();
 
 		static void OnWindowResize(uint32_t width, uint32_t height);
 
 		static void BeginScene(const OrthographicCamera& camera);
 		static void EndScene();
 
+		// Uploads the camera to the SceneData uniform block shared by all engine shaders, once per change of camera
+		static void SetSceneCamera(const OrthographicCamera& camera);
+
+		// Usable while recording for the render thread, like SetSceneCamera and SubmitInstanced
 		static void Submit(const Ref<VertexArray>& vertexArray, const Ref<Shader>& shader, const glm::mat4& transform = glm::mat4(1.f));
+		// Queues a mesh until EndScene, which draws all meshes sharing a shader and a MeshBuffer with one multi-draw.
+		// EndScene with queued meshes calls the graphics API itself and is not usable while recording for the render thread.
+		// The shader reads the model matrix from the DrawData storage block, see assets/shaders/meshShader.glsl.
+		static void Submit(const Ref<MeshBuffer>& meshBuffer, uint32_t mesh, const Ref<Shader>& shader, const glm::mat4& transform = glm::mat4(1.f));
+		// Per-instance data comes from vertex buffers whose layout elements have a divisor
+		static void SubmitInstanced(const Ref<VertexArray>& vertexArray, const Ref<Shader>& shader, uint32_t instanceCount);
 
 		static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
+
+		// Counters of the queued mesh submissions
+		struct Statistics
+		{
+			uint32_t DrawCalls = 0;
+			uint32_t MeshCount = 0;
+		};
+		static Statistics GetStats();
+		static void ResetStats();
 	private:
+		// Mirrors the std140 SceneData block declared by the shaders
 		struct SceneData
 		{
 			glm::mat4 ViewProjectionMat;
 		};
 
 		static SceneData* m_SceneData;
+
+		static void UploadSceneCamera(const glm::mat4& viewProjection);
 	};
 }
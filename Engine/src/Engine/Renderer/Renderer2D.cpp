@@ -2,100 +2,697 @@
 #include "Renderer2D.h"
 
 #include "Engine/Renderer/RenderCommand.h"
+#include "Renderer.h"
 #include "VertexArray.h"
 #include "Shader.h"
+#include "QuadTransform.h"
+#include "RenderQueueSorter.h"
+#include "StreamingBuffer.h"
+#include "Engine/Core/SIMD.h"
 #include <glm/ext/matrix_transform.hpp>
 
 namespace Engine
 {
+	struct QuadVertex
+	{
+		glm::vec3 Position;
+		// RGBA8
+		uint32_t Color;
+		// Normalized shorts; texture coordinates stay within [0, 1], tiling is applied in the shader
+		int16_t TexCoord[2];
+		// Texture slot and tiling factor as half floats
+		uint16_t TexParams[2];
+	};
+
+	// Shapes are drawn as a quad whose fragments evaluate a rounded box distance in local units
+	struct ShapeVertex
+	{
+		glm::vec3 Position;
+		// RGBA8
+		uint32_t Color;
+		glm::vec2 LocalPosition;
+		glm::vec2 HalfSize;
+		// Outline thickness (0 fills the shape) and corner radius
+		glm::vec2 Stroke;
+	};
+
+	// Everything about a quad except its placement, which lives in Renderer2DStorage::frameTransforms
+	struct QuadSubmission
+	{
+		glm::vec4 Color;
+		// Textured quads: texture coordinates of the lower left and upper right corners.
+		// Shapes: half size, outline thickness and corner radius.
+		glm::vec4 Params;
+		float TilingFactor;
+		uint16_t TextureID;
+		BlendMode Blend;
+		uint8_t ShaderID;
+	};
+
+	// Shaders sharing the quad vertex layout, indexed by the shader id of the sort key
+	enum QuadShaderID : uint8_t
+	{
+		QuadShader_Texture = 0, QuadShader_SDFText, QuadShader_Shape, QuadShader_Count
+	};
+
 	struct Renderer2DStorage
 	{
-		Ref<VertexArray> vertexArray;
-		Ref<Shader> flatColorShader;
-		Ref<Shader> textureShader;
+		uint32_t MaxQuads = 0;
+		uint32_t MaxVertices = 0;
+		uint32_t MaxIndices = 0;
+		// Must not exceed the size of the u_Textures sampler array in textureShader.glsl
+		static constexpr uint32_t MaxShaderTextureSlots = 32;
+		uint32_t MaxTextureSlots = 0;
+
+		Ref<VertexArray> quadVertexArray;
+		Ref<StreamingBuffer> quadVertexBuffer;
+		std::array<Ref<Shader>, QuadShader_Count> quadShaders;
+		// Opaque textured quads use the ALPHA_CUTOUT permutation of the texture shader, created when first drawn
+		Scope<ShaderVariants> textureShaderVariants;
+		Ref<Shader> cutoutTextureShader;
+		Ref<Texture2D> whiteTexture;
+
+		// Submissions gathered between BeginScene and EndScene, in submission order
+		std::vector<QuadSubmission> submissions;
+		std::vector<uint64_t> sortKeys;
+		QuadTransformArray frameTransforms;
+		RenderQueueSorter sorter;
+
+		// Textures referenced this frame; the index doubles as the texture id of the sort key
+		std::vector<Ref<Texture2D>> frameTextures;
+		std::unordered_map<uint32_t, uint16_t> frameTextureIDs;
+
+		BlendMode blendMode = BlendMode::Alpha;
+		uint8_t sortLayer = 0;
+
+		// Camera bounds of the current scene as (max.x, max.y, -min.x, -min.y), see IsQuadVisible
+		bool cullingEnabled = true;
+		float cullLimits[4] = { 0.f, 0.f, 0.f, 0.f };
+
+		// CPU-side staging for the current batch, uploaded once per flush
+		uint32_t quadIndexCount = 0;
+		QuadVertex* quadVertexBufferBase = nullptr;
+		QuadVertex* quadVertexBufferPtr = nullptr;
+		// Quad corner positions are filled in from these at flush time
+		QuadTransformArray quadTransforms;
+
+		// Shapes use their own vertex format; a batch holds either quads or shapes, never both
+		Ref<VertexArray> shapeVertexArray;
+		Ref<StreamingBuffer> shapeVertexBuffer;
+		ShapeVertex* shapeVertexBufferBase = nullptr;
+		ShapeVertex* shapeVertexBufferPtr = nullptr;
+
+		// Slot 0 is always the white texture; a batch only splits once every slot is taken
+		std::array<Texture2D*, MaxShaderTextureSlots> textureSlots;
+		std::array<uint16_t, MaxShaderTextureSlots> textureSlotIDs;
+		uint32_t textureSlotIndex = 1;
+		uint8_t batchShader = QuadShader_Texture;
+		BlendMode batchBlend = BlendMode::Alpha;
+
+		glm::vec2 quadTexCoords[4];
+
+		Renderer2D::Statistics stats;
 	};
 
 	static Renderer2DStorage* s_data;
 
-	void Renderer2D::Init()
+	// Texture shader permutations drawn with by the last run, built at Init so none compiles mid-frame
+	static const char* TextureShaderUsagePath = "cache/shaders/textureShader.variants";
+
+	// Sort key layout, most significant bits first:
+	//   Opaque:   [63..62] 0 | [61..54] layer | [53..46] shader | [45..30] texture | [29..6] depth, front to back
+	//   Alpha:    [63..62] 1 | [61..54] layer | [53..30] depth, back to front | rest 0, the stable sort keeps submission order
+	//   Additive: [63..62] 2 | [61..54] layer | [53..46] shader | [45..30] texture, blending commutes so state decides
+	// Opaque geometry draws first and writes depth, so it can be grouped by state freely.
+	// Signed normalized 16-bit value as read by ShaderDataType::Short2Norm
+	static inline int16_t FloatToSNorm16(float value)
 	{
-		s_data = new Renderer2DStorage();
+		return (int16_t)std::lround(std::min(std::max(value, -1.f), 1.f) * 32767.f);
+	}
 
-		s_data->vertexArray = VertexArray::Create();
+	static uint32_t QuantizeDepth(float z)
+	{
+		// The orthographic camera keeps z in [-1, 1], larger z being closer to the viewer
+		float t = std::min(std::max((z + 1.f) * .5f, 0.f), 1.f);
+		return (uint32_t)(t * (float)0xffffff);
+	}
 
-		float squareVertices[5 * 4] =
+	static uint64_t MakeSortKey(BlendMode blend, uint8_t layer, uint8_t shaderID, uint16_t textureID, float z)
+	{
+		uint64_t key = ((uint64_t)blend << 62) | ((uint64_t)layer << 54);
+		switch (blend)
 		{
-			-.5f, -.5f, .0f, 0.0f, 0.0f,
-			 .5f, -.5f, .0f, 1.0f, 0.0f,
-			 .5f,  .5f, .0f, 1.0f, 1.0f,
-			-.5f,  .5f, .0f, 0.0f, 1.0f
-		};
+		case BlendMode::Opaque:
+			key |= ((uint64_t)shaderID << 46) | ((uint64_t)textureID << 30) | ((uint64_t)(0xffffff - QuantizeDepth(z)) << 6);
+			break;
+		case BlendMode::Alpha:
+			key |= (uint64_t)QuantizeDepth(z) << 30;
+			break;
+		case BlendMode::Additive:
+			key |= ((uint64_t)shaderID << 46) | ((uint64_t)textureID << 30);
+			break;
+		}
+		return key;
+	}
 
-		std::shared_ptr<VertexBuffer> squareVB;
-		squareVB.reset(VertexBuffer::Create(squareVertices, sizeof(squareVertices)));
+	static void CreateQuadBuffers(uint32_t maxQuads)
+	{
+		s_data->MaxQuads = maxQuads;
+		s_data->MaxVertices = maxQuads * 4;
+		s_data->MaxIndices = maxQuads * 6;
 
-		BufferLayout squareLayout =
-		{
+		s_data->quadVertexArray = VertexArray::Create();
+
+		// One batch per region; three regions keep the GPU a couple of batches behind without stalling
+		s_data->quadVertexBuffer.reset(StreamingBuffer::Create(s_data->MaxVertices * sizeof(QuadVertex), 3));
+		s_data->quadVertexBuffer->SetLayout({
 			{ShaderDataType::Float3, "a_Position"},
-			{ShaderDataType::Float2, "a_TexCoord"},
-		};
-		squareVB->SetLayout(squareLayout);
-		s_data->vertexArray->AddVertexBuffer(squareVB);
+			{ShaderDataType::UByte4Norm, "a_Color"},
+			{ShaderDataType::Short2Norm, "a_TexCoord"},
+			{ShaderDataType::Half2, "a_TexParams"},
+		});
+		Ref<VertexBuffer> quadVB = s_data->quadVertexBuffer;
+		s_data->quadVertexArray->AddVertexBuffer(quadVB);
+
+		delete[] s_data->quadVertexBufferBase;
+		s_data->quadVertexBufferBase = new QuadVertex[s_data->MaxVertices];
+		s_data->quadTransforms.Reserve(maxQuads);
+
+		Ref<IndexBuffer> quadIB = IndexBuffer::GetQuadIndexBuffer(maxQuads);
+		s_data->quadVertexArray->SetIndexBuffer(quadIB);
+
+		s_data->shapeVertexArray = VertexArray::Create();
+		s_data->shapeVertexBuffer.reset(StreamingBuffer::Create(s_data->MaxVertices * sizeof(ShapeVertex), 3));
+		s_data->shapeVertexBuffer->SetLayout({
+			{ShaderDataType::Float3, "a_Position"},
+			{ShaderDataType::UByte4Norm, "a_Color"},
+			{ShaderDataType::Float2, "a_LocalPosition"},
+			{ShaderDataType::Float2, "a_HalfSize"},
+			{ShaderDataType::Float2, "a_Stroke"},
+		});
+		Ref<VertexBuffer> shapeVB = s_data->shapeVertexBuffer;
+		s_data->shapeVertexArray->AddVertexBuffer(shapeVB);
+		s_data->shapeVertexArray->SetIndexBuffer(quadIB);
+
+		delete[] s_data->shapeVertexBufferBase;
+		s_data->shapeVertexBufferBase = new ShapeVertex[s_data->MaxVertices];
+	}
+
+	static void StartBatch()
+	{
+		s_data->quadIndexCount = 0;
+		s_data->quadVertexBufferPtr = s_data->quadVertexBufferBase;
+		s_data->shapeVertexBufferPtr = s_data->shapeVertexBufferBase;
+		s_data->textureSlotIndex = 1;
+	}
+
+	static void SetTextureSamplers(const Ref<Shader>& shader)
+	{
+		int samplers[Renderer2DStorage::MaxShaderTextureSlots];
+		for (uint32_t i = 0; i < s_data->MaxTextureSlots; i++)
+			samplers[i] = i;
+		UniformHandle<int>(shader, "u_Textures"_sid).Set(samplers, s_data->MaxTextureSlots);
+	}
+
+	static const Ref<Shader>& GetBatchQuadShader()
+	{
+		if (s_data->batchShader != QuadShader_Texture || s_data->batchBlend != BlendMode::Opaque)
+			return s_data->quadShaders[s_data->batchShader];
 
-		uint32_t squareIndices[6] =
+		if (!s_data->cutoutTextureShader)
 		{
-			0,1,2,2,3,0
-		};
-		std::shared_ptr<IndexBuffer> squareIB;
-		squareIB.reset(IndexBuffer::Create(squareIndices, sizeof(squareIndices) / sizeof(uint32_t)));
-		s_data->vertexArray->SetIndexBuffer(squareIB);
+			s_data->cutoutTextureShader = s_data->textureShaderVariants->Get({ { "ALPHA_CUTOUT", "1" } });
+			SetTextureSamplers(s_data->cutoutTextureShader);
+		}
+		return s_data->cutoutTextureShader;
+	}
+
+	static void FlushBatch()
+	{
+		RenderCommand::RequireContext("Renderer2D");
+		if (s_data->quadIndexCount == 0)
+			return;
+
+		uint32_t quadCount = s_data->quadIndexCount / 6;
+		if (s_data->batchShader == QuadShader_Shape)
+		{
+			TransformQuads(s_data->quadTransforms, 0, quadCount, s_data->shapeVertexBufferBase, sizeof(ShapeVertex));
+
+			uint32_t dataSize = (uint32_t)((uint8_t*)s_data->shapeVertexBufferPtr - (uint8_t*)s_data->shapeVertexBufferBase);
+			void* dest = s_data->shapeVertexBuffer->BeginWrite(dataSize);
+			memcpy(dest, s_data->shapeVertexBufferBase, dataSize);
+			s_data->shapeVertexBuffer->EndWrite(dataSize);
 
-		s_data->flatColorShader = Shader::Create("assets/shaders/flatColorShader.glsl");
-		s_data->textureShader = Shader::Create("assets/shaders/textureShader.glsl");
+			s_data->quadShaders[QuadShader_Shape]->Bind();
+			s_data->shapeVertexArray->Bind();
+			s_data->shapeVertexArray->ValidateLayout(*s_data->quadShaders[QuadShader_Shape]);
+			RenderCommand::DrawIndexed(s_data->shapeVertexArray, s_data->quadIndexCount, s_data->shapeVertexBuffer->GetBaseVertex());
+		}
+		else
+		{
+			TransformQuads(s_data->quadTransforms, 0, quadCount, s_data->quadVertexBufferBase, sizeof(QuadVertex));
+
+			uint32_t dataSize = (uint32_t)((uint8_t*)s_data->quadVertexBufferPtr - (uint8_t*)s_data->quadVertexBufferBase);
+			void* dest = s_data->quadVertexBuffer->BeginWrite(dataSize);
+			memcpy(dest, s_data->quadVertexBufferBase, dataSize);
+			s_data->quadVertexBuffer->EndWrite(dataSize);
+
+			for (uint32_t i = 0; i < s_data->textureSlotIndex; i++)
+				s_data->textureSlots[i]->Bind(i);
+			const Ref<Shader>& shader = GetBatchQuadShader();
+			shader->Bind();
+			s_data->quadVertexArray->Bind();
+			s_data->quadVertexArray->ValidateLayout(*shader);
+			RenderCommand::DrawIndexed(s_data->quadVertexArray, s_data->quadIndexCount, s_data->quadVertexBuffer->GetBaseVertex());
+		}
 
+		s_data->stats.DrawCalls++;
+		StartBatch();
+	}
+
+	static void ApplyBlendMode(BlendMode blend)
+	{
+		s_data->batchBlend = blend;
+		RenderCommand::SetBlendMode(blend);
+		RenderCommand::SetDepthWrite(blend == BlendMode::Opaque);
+	}
+
+	static float GetTextureSlot(uint16_t textureID)
+	{
+		for (uint32_t i = 0; i < s_data->textureSlotIndex; i++)
+		{
+			if (s_data->textureSlotIDs[i] == textureID)
+				return (float)i;
+		}
+
+		if (s_data->textureSlotIndex >= s_data->MaxTextureSlots)
+			FlushBatch();
+
+		uint32_t slot = s_data->textureSlotIndex++;
+		s_data->textureSlots[slot] = s_data->frameTextures[textureID].get();
+		s_data->textureSlotIDs[slot] = textureID;
+		return (float)slot;
+	}
+
+	static uint16_t GetFrameTextureID(const Ref<Texture2D>& texture)
+	{
+		uint32_t rendererID = texture->GetRendererID();
+
+		// Consecutive draws usually share a texture
+		uint16_t lastID = (uint16_t)(s_data->frameTextures.size() - 1);
+		if (s_data->frameTextures[lastID]->GetRendererID() == rendererID)
+			return lastID;
+
+		auto it = s_data->frameTextureIDs.find(rendererID);
+		if (it != s_data->frameTextureIDs.end())
+			return it->second;
+
+		EG_CORE_ASSERT(s_data->frameTextures.size() <= 0xffff, "Too many textures in one scene!");
+		uint16_t id = (uint16_t)s_data->frameTextures.size();
+		s_data->frameTextures.push_back(texture);
+		s_data->frameTextureIDs[rendererID] = id;
+		return id;
+	}
+
+	static void ResetFrameTextures()
+	{
+		s_data->frameTextures.clear();
+		s_data->frameTextureIDs.clear();
+
+		s_data->frameTextures.push_back(s_data->whiteTexture);
+		s_data->frameTextureIDs[s_data->whiteTexture->GetRendererID()] = 0;
+	}
+
+	void Renderer2D::Init(uint32_t maxQuadsPerBatch)
+	{
+		s_data = new Renderer2DStorage();
+
+		CreateQuadBuffers(maxQuadsPerBatch);
+
+		s_data->whiteTexture = Texture2D::Create(1, 1);
+		uint32_t whiteTextureData = 0xffffffff;
+		s_data->whiteTexture->SetData(&whiteTextureData, sizeof(uint32_t));
+
+		s_data->MaxTextureSlots = std::min(RenderCommand::GetMaxTextureSlots(), Renderer2DStorage::MaxShaderTextureSlots);
+		s_data->textureSlots[0] = s_data->whiteTexture.get();
+		s_data->textureSlotIDs[0] = 0;
+		ResetFrameTextures();
+
+		// Loaded together so the driver can compile them concurrently
+		s_data->textureShaderVariants.reset(new ShaderVariants("assets/shaders/textureShader.glsl"));
+		s_data->textureShaderVariants->Precompile(ShaderVariants::LoadUsage(TextureShaderUsagePath));
+		ShaderLibrary quadShaderLibrary;
+		s_data->quadShaders[QuadShader_SDFText] = quadShaderLibrary.LoadAsync("assets/shaders/sdfTextShader.glsl");
+		s_data->quadShaders[QuadShader_Shape] = quadShaderLibrary.LoadAsync("assets/shaders/shapeShader.glsl");
+		quadShaderLibrary.SubmitPending();
+		s_data->quadShaders[QuadShader_Texture] = s_data->textureShaderVariants->Get();
+		SetTextureSamplers(s_data->quadShaders[QuadShader_Texture]);
+		SetTextureSamplers(s_data->quadShaders[QuadShader_SDFText]);
+
+		s_data->quadTexCoords[0] = { 0.f, 0.f };
+		s_data->quadTexCoords[1] = { 1.f, 0.f };
+		s_data->quadTexCoords[2] = { 1.f, 1.f };
+		s_data->quadTexCoords[3] = { 0.f, 1.f };
+
+		s_data->frameTransforms.Reserve(maxQuadsPerBatch);
+		s_data->submissions.reserve(maxQuadsPerBatch);
+		s_data->sortKeys.reserve(maxQuadsPerBatch);
 	}
 
 	void Renderer2D::ShutDown()
 	{
+		s_data->textureShaderVariants->SaveUsage(TextureShaderUsagePath);
+
+		delete[] s_data->quadVertexBufferBase;
+		delete[] s_data->shapeVertexBufferBase;
 		delete s_data;
 	}
 
+	void Renderer2D::SetBatchCapacity(uint32_t maxQuadsPerBatch)
+	{
+		EG_CORE_ASSERT(maxQuadsPerBatch, "Batch capacity must hold at least one quad!");
+		if (maxQuadsPerBatch == s_data->MaxQuads)
+			return;
+
+		Flush();
+		CreateQuadBuffers(maxQuadsPerBatch);
+		StartBatch();
+	}
+
+	uint32_t Renderer2D::GetBatchCapacity()
+	{
+		return s_data->MaxQuads;
+	}
+
+	void Renderer2D::SetBlendMode(BlendMode mode)
+	{
+		s_data->blendMode = mode;
+	}
+
+	void Renderer2D::SetSortLayer(uint8_t layer)
+	{
+		s_data->sortLayer = layer;
+	}
+
+	void Renderer2D::SetCulling(bool enabled)
+	{
+		s_data->cullingEnabled = enabled;
+	}
+
 	void Renderer2D::BeginScene(const OrthographicCamera& camera)
 	{
-		s_data->flatColorShader->setMat4fv("viewProjMat", camera.GetViewProjectionMatrix());
-		s_data->textureShader->setMat4fv("viewProjMat", camera.GetViewProjectionMatrix());
+		Renderer::SetSceneCamera(camera);
+
+		const OrthographicCamera::Bounds& bounds = camera.GetVisibleBounds();
+		s_data->cullLimits[0] = bounds.Max.x;
+		s_data->cullLimits[1] = bounds.Max.y;
+		s_data->cullLimits[2] = -bounds.Min.x;
+		s_data->cullLimits[3] = -bounds.Min.y;
+
+		s_data->blendMode = BlendMode::Alpha;
+		s_data->sortLayer = 0;
+		StartBatch();
 	}
 
 	void Renderer2D::EndScene()
 	{
+		Flush();
+	}
+
+	void Renderer2D::Flush()
+	{
+		uint32_t count = (uint32_t)s_data->submissions.size();
+		if (count == 0)
+			return;
+
+		const uint32_t* order = s_data->sorter.Sort(s_data->sortKeys.data(), count);
+
+		RenderCommand::SetDepthTest(true);
+		BlendMode currentBlend = s_data->submissions[order[0]].Blend;
+		ApplyBlendMode(currentBlend);
+		s_data->batchShader = s_data->submissions[order[0]].ShaderID;
+
+		StartBatch();
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint32_t index = order[i];
+			const QuadSubmission& quad = s_data->submissions[index];
+
+			if (quad.Blend != currentBlend)
+			{
+				FlushBatch();
+				currentBlend = quad.Blend;
+				ApplyBlendMode(currentBlend);
+			}
+
+			if (quad.ShaderID != s_data->batchShader)
+			{
+				FlushBatch();
+				s_data->batchShader = quad.ShaderID;
+			}
+
+			if (s_data->quadIndexCount >= s_data->MaxIndices)
+				FlushBatch();
+
+			if (quad.ShaderID == QuadShader_Shape)
+			{
+				s_data->quadTransforms.Set(s_data->quadIndexCount / 6, s_data->frameTransforms, index);
+				glm::vec2 halfSize = { quad.Params.x, quad.Params.y };
+				uint32_t color = SIMD::FloatToRGBA8(&quad.Color.x);
+				for (size_t v = 0; v < 4; v++)
+				{
+					const glm::vec2& corner = s_data->quadTexCoords[v];
+					s_data->shapeVertexBufferPtr->Color = color;
+					s_data->shapeVertexBufferPtr->LocalPosition = { (corner.x * 2.f - 1.f) * halfSize.x, (corner.y * 2.f - 1.f) * halfSize.y };
+					s_data->shapeVertexBufferPtr->HalfSize = halfSize;
+					s_data->shapeVertexBufferPtr->Stroke = { quad.Params.z, quad.Params.w };
+					s_data->shapeVertexBufferPtr++;
+				}
+				s_data->quadIndexCount += 6;
+				continue;
+			}
+
+			float textureIndex = GetTextureSlot(quad.TextureID);
+
+			// Everything but the texture coordinate corner is the same for the four vertices
+			uint32_t color = SIMD::FloatToRGBA8(&quad.Color.x);
+			uint16_t texParams[2] = { SIMD::FloatToHalf(textureIndex), SIMD::FloatToHalf(quad.TilingFactor) };
+			int16_t texRect[4] = { FloatToSNorm16(quad.Params.x), FloatToSNorm16(quad.Params.y), FloatToSNorm16(quad.Params.z), FloatToSNorm16(quad.Params.w) };
+
+			s_data->quadTransforms.Set(s_data->quadIndexCount / 6, s_data->frameTransforms, index);
+			for (size_t v = 0; v < 4; v++)
+			{
+				const glm::vec2& corner = s_data->quadTexCoords[v];
+				s_data->quadVertexBufferPtr->Color = color;
+				s_data->quadVertexBufferPtr->TexCoord[0] = corner.x > .5f ? texRect[2] : texRect[0];
+				s_data->quadVertexBufferPtr->TexCoord[1] = corner.y > .5f ? texRect[3] : texRect[1];
+				s_data->quadVertexBufferPtr->TexParams[0] = texParams[0];
+				s_data->quadVertexBufferPtr->TexParams[1] = texParams[1];
+				s_data->quadVertexBufferPtr++;
+			}
+			s_data->quadIndexCount += 6;
+		}
+		FlushBatch();
+		s_data->quadVertexBuffer->EndFrame();
+		s_data->shapeVertexBuffer->EndFrame();
+
+		// Leave the state other renderers expect
+		RenderCommand::SetDepthTest(false);
+		RenderCommand::SetDepthWrite(true);
+		RenderCommand::SetBlendMode(BlendMode::Alpha);
+
+		s_data->submissions.clear();
+		s_data->sortKeys.clear();
+		ResetFrameTextures();
+	}
+
+	// Overlap test of the quad's xy bounding box with the camera bounds. Both boxes are packed as
+	// (min.x, min.y, -max.x, -max.y) against (max.x, max.y, -min.x, -min.y), so one compare covers all four sides.
+	static inline bool IsQuadVisible(const glm::vec3& center, const glm::vec3& halfAxisX, const glm::vec3& halfAxisY)
+	{
+#ifdef EG_SIMD_X86
+		const __m128 signMask = _mm_set1_ps(-0.f);
+		__m128 c = _mm_setr_ps(center.x, center.y, -center.x, -center.y);
+		__m128 ax = _mm_andnot_ps(signMask, _mm_setr_ps(halfAxisX.x, halfAxisX.y, halfAxisX.x, halfAxisX.y));
+		__m128 ay = _mm_andnot_ps(signMask, _mm_setr_ps(halfAxisY.x, halfAxisY.y, halfAxisY.x, halfAxisY.y));
+		__m128 lower = _mm_sub_ps(c, _mm_add_ps(ax, ay));
+		return _mm_movemask_ps(_mm_cmple_ps(lower, _mm_loadu_ps(s_data->cullLimits))) == 0xf;
+#else
+		float extentX = fabsf(halfAxisX.x) + fabsf(halfAxisY.x);
+		float extentY = fabsf(halfAxisX.y) + fabsf(halfAxisY.y);
+		const float* limits = s_data->cullLimits;
+		return center.x - extentX <= limits[0] && center.y - extentY <= limits[1]
+			&& -center.x - extentX <= limits[2] && -center.y - extentY <= limits[3];
+#endif
 	}
 
-	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, glm::vec4& color)
+	static const glm::vec4 s_FullTexRect = { 0.f, 0.f, 1.f, 1.f };
+
+	static void SubmitQuad(const glm::vec3& center, const glm::vec3& halfAxisX, const glm::vec3& halfAxisY, const glm::vec4& color, const Ref<Texture2D>& texture, float tilingFactor,
+		const glm::vec4& params = s_FullTexRect, uint8_t shaderID = QuadShader_Texture)
+	{
+		if (s_data->cullingEnabled && !IsQuadVisible(center, halfAxisX, halfAxisY))
+		{
+			s_data->stats.CulledQuadCount++;
+			return;
+		}
+
+		uint32_t index = (uint32_t)s_data->submissions.size();
+		if (index >= s_data->frameTransforms.GetCapacity())
+			s_data->frameTransforms.Reserve(index * 2);
+		s_data->frameTransforms.Set(index, center, halfAxisX, halfAxisY);
+
+		uint16_t textureID = GetFrameTextureID(texture);
+		s_data->submissions.push_back({ color, params, tilingFactor, textureID, s_data->blendMode, shaderID });
+		s_data->sortKeys.push_back(MakeSortKey(s_data->blendMode, s_data->sortLayer, shaderID, textureID, center.z));
+
+		s_data->stats.QuadCount++;
+	}
+
+	// Translate * scale, without building the matrix
+	static inline void SubmitQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color, const Ref<Texture2D>& texture, float tilingFactor)
+	{
+		SubmitQuad(position, { size.x * .5f, 0.f, 0.f }, { 0.f, size.y * .5f, 0.f }, color, texture, tilingFactor);
+	}
+
+	// Translate * rotate(z) * scale, without building the matrix
+	static inline void SubmitRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color, const Ref<Texture2D>& texture, float tilingFactor)
+	{
+		float c = cosf(rotation);
+		float s = sinf(rotation);
+		glm::vec2 halfSize = size * .5f;
+		SubmitQuad(position, { c * halfSize.x, s * halfSize.x, 0.f }, { -s * halfSize.y, c * halfSize.y, 0.f }, color, texture, tilingFactor);
+	}
+
+	static inline void SubmitQuad(const glm::mat4& transform, const glm::vec4& color, const Ref<Texture2D>& texture, float tilingFactor)
+	{
+		glm::vec3 center = { transform[3].x, transform[3].y, transform[3].z };
+		glm::vec3 halfAxisX = { transform[0].x * .5f, transform[0].y * .5f, transform[0].z * .5f };
+		glm::vec3 halfAxisY = { transform[1].x * .5f, transform[1].y * .5f, transform[1].z * .5f };
+		SubmitQuad(center, halfAxisX, halfAxisY, color, texture, tilingFactor);
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
 	{
 		DrawQuad(glm::vec3(position.x, position.y, 0.f), size, color);
 	}
 
-	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, glm::vec4& color)
+	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
+	{
+		SubmitQuad(position, size, color, s_data->whiteTexture, 1.f);
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
 	{
-		s_data->flatColorShader->set4fv("color", color);
+		DrawQuad(glm::vec3(position.x, position.y, 0.f), size, texture, tilingFactor, tintColor);
+	}
 
-		s_data->flatColorShader->setMat4fv("modelMat", glm::scale(glm::translate(glm::mat4(1.f), position), glm::vec3(size.x, size.y, 1.f)));
-		s_data->vertexArray->Bind();
-		RenderCommand::DrawIndexed(s_data->vertexArray);
+	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
+	{
+		SubmitQuad(position, size, tintColor, texture, tilingFactor);
 	}
 
-	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<Texture2D>& texture)
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const glm::vec4& color)
 	{
-		DrawQuad(glm::vec3(position.x, position.y, 0.f), size, texture);
+		SubmitQuad(transform, color, s_data->whiteTexture, 1.f);
 	}
 
-	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<Texture2D>& texture)
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
 	{
+		SubmitQuad(transform, tintColor, texture, tilingFactor);
+	}
 
-		s_data->textureShader->setMat4fv("modelMat", glm::scale(glm::translate(glm::mat4(1.f), position), glm::vec3(size.x, size.y, 1.f)));
+	void Renderer2D::DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec4& color)
+	{
+		DrawRotatedQuad(glm::vec3(position.x, position.y, 0.f), size, rotation, color);
+	}
 
-		texture->Bind();
-		s_data->vertexArray->Bind();
-		RenderCommand::DrawIndexed(s_data->vertexArray);
+	void Renderer2D::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color)
+	{
+		SubmitRotatedQuad(position, size, rotation, color, s_data->whiteTexture, 1.f);
+	}
+
+	void Renderer2D::DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
+	{
+		DrawRotatedQuad(glm::vec3(position.x, position.y, 0.f), size, rotation, texture, tilingFactor, tintColor);
+	}
+
+	void Renderer2D::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
+	{
+		SubmitRotatedQuad(position, size, rotation, tintColor, texture, tilingFactor);
+	}
+
+	// The quad spans halfSize along each axis; the distance is evaluated in those units, so shapes keep
+	// their proportions under non-uniform transforms only if the axes are orthogonal
+	static inline void SubmitShape(const glm::vec3& center, const glm::vec3& axisX, const glm::vec3& axisY, const glm::vec2& halfSize, const glm::vec4& color, float thickness, float cornerRadius)
+	{
+		float radius = std::min(std::max(cornerRadius, 0.f), std::min(halfSize.x, halfSize.y));
+		glm::vec4 params = { halfSize.x, halfSize.y, std::max(thickness, 0.f), radius };
+		SubmitQuad(center, { axisX.x * halfSize.x, axisX.y * halfSize.x, axisX.z * halfSize.x }, { axisY.x * halfSize.y, axisY.y * halfSize.y, axisY.z * halfSize.y },
+			color, s_data->whiteTexture, 1.f, params, QuadShader_Shape);
+	}
+
+	void Renderer2D::DrawLine(const glm::vec3& start, const glm::vec3& end, float thickness, const glm::vec4& color)
+	{
+		glm::vec3 delta = { end.x - start.x, end.y - start.y, end.z - start.z };
+		float length = sqrtf(delta.x * delta.x + delta.y * delta.y);
+		glm::vec3 direction = length > 0.f ? glm::vec3(delta.x / length, delta.y / length, 0.f) : glm::vec3(1.f, 0.f, 0.f);
+		glm::vec3 normal = { -direction.y, direction.x, 0.f };
+		glm::vec3 center = { (start.x + end.x) * .5f, (start.y + end.y) * .5f, (start.z + end.z) * .5f };
+
+		// A capsule: the ends are rounded by the half thickness
+		float halfThickness = thickness * .5f;
+		SubmitShape(center, direction, normal, { length * .5f + halfThickness, halfThickness }, color, 0.f, halfThickness);
+	}
+
+	void Renderer2D::DrawCircle(const glm::vec3& center, float radius, const glm::vec4& color, float thickness)
+	{
+		SubmitShape(center, { 1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }, { radius, radius }, color, thickness, radius);
+	}
+
+	void Renderer2D::DrawRect(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color, float thickness, float cornerRadius)
+	{
+		SubmitShape(position, { 1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }, { size.x * .5f, size.y * .5f }, color, thickness, cornerRadius);
+	}
+
+	void Renderer2D::DrawRect(const glm::mat4& transform, const glm::vec4& color, float thickness, float cornerRadius)
+	{
+		glm::vec3 center = { transform[3].x, transform[3].y, transform[3].z };
+		glm::vec3 axisX = { transform[0].x, transform[0].y, transform[0].z };
+		glm::vec3 axisY = { transform[1].x, transform[1].y, transform[1].z };
+		float lengthX = sqrtf(axisX.x * axisX.x + axisX.y * axisX.y + axisX.z * axisX.z);
+		float lengthY = sqrtf(axisY.x * axisY.x + axisY.y * axisY.y + axisY.z * axisY.z);
+		if (lengthX == 0.f || lengthY == 0.f)
+			return;
+
+		axisX = { axisX.x / lengthX, axisX.y / lengthX, axisX.z / lengthX };
+		axisY = { axisY.x / lengthY, axisY.y / lengthY, axisY.z / lengthY };
+		SubmitShape(center, axisX, axisY, { lengthX * .5f, lengthY * .5f }, color, thickness, cornerRadius);
+	}
+
+	void Renderer2D::DrawString(const std::string& text, const Ref<Font>& font, const glm::vec3& position, float size, const glm::vec4& color)
+	{
+		const Ref<Texture2D>& atlas = font->GetAtlasTexture();
+		if (!atlas)
+			return;
+
+		const Font::GlyphRun& run = font->GetGlyphRun(text);
+		for (const Font::GlyphQuad& glyph : run.Quads)
+		{
+			glm::vec2 halfSize = { (glyph.Max.x - glyph.Min.x) * size * .5f, (glyph.Max.y - glyph.Min.y) * size * .5f };
+			glm::vec3 center = { position.x + glyph.Min.x * size + halfSize.x, position.y + glyph.Min.y * size + halfSize.y, position.z };
+			glm::vec4 texRect = { glyph.TexCoordMin.x, glyph.TexCoordMin.y, glyph.TexCoordMax.x, glyph.TexCoordMax.y };
+			SubmitQuad(center, { halfSize.x, 0.f, 0.f }, { 0.f, halfSize.y, 0.f }, color, atlas, 1.f, texRect, QuadShader_SDFText);
+		}
+	}
+
+	Renderer2D::Statistics Renderer2D::GetStats()
+	{
+		return s_data->stats;
+	}
+
+	void Renderer2D::ResetStats()
+	{
+		memset(&s_data->stats, 0, sizeof(Statistics));
 	}
-}
\ No newline at end of file
+}
@@ -3,22 +3,74 @@
 #pragma once
 #include "OrthographicCamera.h"
 #include "Texture.h"
+#include "Font.h"
+#include "RendererAPI.h"
 
 namespace Engine
 {
 	class Renderer2D
 	{
 	public:
-		static void Init();
+		static void Init(uint32_t maxQuadsPerBatch = 10000);
 		static void ShutDown();
 
 		static void BeginScene(const OrthographicCamera& camera);
 		static void EndScene();
+		// Sorts everything submitted so far and draws it
+		static void Flush();
+
+		// Applies to subsequent submissions until the next BeginScene, which resets to Alpha and layer 0.
+		// Opaque quads write depth and are grouped by texture; apart from shapes and text they drop
+		// fragments below half alpha. Alpha quads are drawn back to front by (layer, z) after them,
+		// in submission order when those are equal.
+		static void SetBlendMode(BlendMode mode);
+		static void SetSortLayer(uint8_t layer);
+
+		// Quads entirely outside the camera bounds given to BeginScene are dropped at submission (on by default)
+		static void SetCulling(bool enabled);
+
+		// Number of quads gathered before a batch is forced to flush
+		static void SetBatchCapacity(uint32_t maxQuadsPerBatch);
+		static uint32_t GetBatchCapacity();
 
 		// Primitives
-		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, glm::vec4& color);
-		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, glm::vec4& color);
-		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<Texture2D>& texture);
-		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<Texture2D>& texture);
+		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
+		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4(1.f));
+		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4(1.f));
+
+		static void DrawQuad(const glm::mat4& transform, const glm::vec4& color);
+		static void DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4(1.f));
+
+		// Rotation is in radians, counter-clockwise about the quad center
+		static void DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec4& color);
+		static void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color);
+		static void DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4(1.f));
+		static void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor = 1.f, const glm::vec4& tintColor = glm::vec4(1.f));
+
+		// Shapes are one quad each, with edges computed per pixel. A thickness of 0 fills the shape,
+		// anything else draws an outline of that width inside its bounds. Lines have round caps.
+		// Like text, shapes are antialiased through blending.
+		static void DrawLine(const glm::vec3& start, const glm::vec3& end, float thickness, const glm::vec4& color);
+		static void DrawCircle(const glm::vec3& center, float radius, const glm::vec4& color, float thickness = 0.f);
+		static void DrawRect(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color, float thickness = 0.f, float cornerRadius = 0.f);
+		static void DrawRect(const glm::mat4& transform, const glm::vec4& color, float thickness = 0.f, float cornerRadius = 0.f);
+
+		// Text starts on the baseline at position, size is the line height in world units. Glyph edges are
+		// antialiased through blending, so draw text with the Alpha blend mode.
+		static void DrawString(const std::string& text, const Ref<Font>& font, const glm::vec3& position, float size, const glm::vec4& color = glm::vec4(1.f));
+
+		struct Statistics
+		{
+			uint32_t DrawCalls = 0;
+			// Quads kept for drawing and quads rejected by culling
+			uint32_t QuadCount = 0;
+			uint32_t CulledQuadCount = 0;
+
+			uint32_t GetTotalVertexCount() const { return QuadCount * 4; }
+			uint32_t GetTotalIndexCount() const { return QuadCount * 6; }
+		};
+		static Statistics GetStats();
+		static void ResetStats();
 	};
 }
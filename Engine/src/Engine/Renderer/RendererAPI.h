@@ -4,6 +4,24 @@
 
 namespace Engine
 {
+	enum class BlendMode : uint8_t
+	{
+		Opaque = 0, Alpha, Additive
+	};
+
+	// Which kinds of later reads must see data written by shaders, see RenderCommand::InsertMemoryBarrier
+	enum MemoryBarrierBits : uint32_t
+	{
+		MemoryBarrier_ShaderStorage = BIT(0),
+		MemoryBarrier_Command = BIT(1),
+		MemoryBarrier_VertexAttribute = BIT(2),
+		// Buffer updates, clears and reads back through the buffer API
+		MemoryBarrier_BufferUpdate = BIT(3),
+		MemoryBarrier_All = 0xffffffff
+	};
+
+	class RenderCommandQueue;
+
 	class RendererAPI
 	{
 	public:
@@ -17,7 +35,37 @@ namespace Engine
 		virtual void SetClearColor(const glm::vec4& color) = 0;
 		virtual void Clear() = 0;
 
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray) = 0;
+		virtual void SetBlendMode(BlendMode mode) = 0;
+		virtual void SetDepthTest(bool enabled) = 0;
+		virtual void SetDepthWrite(bool enabled) = 0;
+
+		// baseVertex is added to every index, e.g. to draw data streamed at an offset
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t baseVertex = 0) = 0;
+		// baseInstance offsets the per-instance attributes, e.g. to draw instance data streamed at an offset
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount = 0, uint32_t baseInstance = 0) = 0;
+
+		// Draws with the DrawArraysIndirectCommand at offset in indirectBuffer
+		virtual void DrawArraysIndirect(const Ref<VertexArray>& vertexArray, const Ref<IndirectBuffer>& indirectBuffer, uint32_t offset = 0) = 0;
+		// Issues drawCount DrawElementsIndirectCommands starting at offset in one call; shaders tell them apart by gl_DrawID
+		virtual void MultiDrawIndexedIndirect(const Ref<VertexArray>& vertexArray, const Ref<IndirectBuffer>& indirectBuffer, uint32_t drawCount, uint32_t offset = 0) = 0;
+
+		// Runs the bound compute shader
+		virtual void DispatchCompute(uint32_t groupsX, uint32_t groupsY = 1, uint32_t groupsZ = 1) = 0;
+		virtual void InsertMemoryBarrier(uint32_t barriers) = 0;
+
+		virtual uint32_t GetMaxTextureSlots() const = 0;
+
+		// State changes skipped because the state was already set (hits) and those that reached the driver
+		struct StateCacheStatistics
+		{
+			uint32_t Hits = 0;
+			uint32_t Misses = 0;
+		};
+		virtual StateCacheStatistics GetStateCacheStats() const = 0;
+		virtual void ResetStateCacheStats() = 0;
+
+		// Replays the commands recorded into queue, in order
+		virtual void Execute(const RenderCommandQueue& queue) = 0;
 
 		static API GetAPI() { return s_API; }
 	private:
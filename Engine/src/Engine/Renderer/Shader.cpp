@@ -1,28 +1,51 @@
 #include "engine_pch.h"
 #include "Shader.h"
 
+#include <filesystem>
 #include <fstream>
 #include <glm/gtc/type_ptr.hpp>
 
 #include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/HotReload.h"
 #include "Platform/OpenGL/OpenGLShader.h"
+#include "Engine/Core/JobSystem.h"
 
 
 namespace Engine
 {
 	Ref<Shader> Shader::Create(const char* shaderFile)
 	{
+		RenderCommand::RequireContext("Shader");
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::OpenGL:
-			return std::make_shared<OpenGLShader>(shaderFile);
-			break;
+		{
+			Ref<Shader> shader = std::make_shared<OpenGLShader>(shaderFile);
+			HotReload::Register(shader);
+			return shader;
+		}
+		}
+		EG_CORE_ASSERT(false, "Shader case is currently not supported!");
+	}
+
+	Ref<Shader> Shader::CreateAsync(const char* shaderFile, const ShaderDefines& defines)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::OpenGL:
+		{
+			Ref<Shader> shader = std::make_shared<OpenGLShader>(shaderFile, OpenGLShader::DeferredLoad(), defines);
+			HotReload::Register(shader);
+			return shader;
+		}
 		}
 		EG_CORE_ASSERT(false, "Shader case is currently not supported!");
+		return nullptr;
 	}
 
 	Ref<Shader> Shader::Create(const char* vertexShaderFile, const char* fragmentShaderFile, const char* geometricShaderFile)
 	{
+		RenderCommand::RequireContext("Shader");
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::OpenGL:
@@ -34,6 +57,7 @@ namespace Engine
 
 	Ref<Shader> Shader::Create(int dummy, const char* shaderName, const char* vertexShaderCode, const char* fragmentShaderCode, const char* geometricShaderCode)
 	{
+		RenderCommand::RequireContext("Shader");
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::OpenGL:
@@ -52,7 +76,7 @@ namespace Engine
 
 	}
 
-	void ShaderLibrary::Add(const std::string& name, const Ref<Shader>& shader)
+	void ShaderLibrary::Add(StringId name, const Ref<Shader>& shader)
 	{
 		EG_CORE_ASSERT(!Exists(name), "Shader already exists!");
 		m_Shaders[name] = shader;
@@ -60,9 +84,7 @@ namespace Engine
 
 	void ShaderLibrary::Add(const Ref<Shader>& shader)
 	{
-		auto& name = shader->GetName();
-		EG_CORE_ASSERT(!Exists(name), "Shader already exists!");
-		m_Shaders[shader->GetName()] = shader;
+		Add(StringId(shader->GetName()), shader);
 	}
 	
 	Ref<Shader> ShaderLibrary::Load(const std::string& filepath)
@@ -75,17 +97,140 @@ namespace Engine
 	Ref<Shader> ShaderLibrary::Load(const std::string& name, const std::string& filepath)
 	{
 		auto shader = Shader::Create(filepath.c_str());
-		Add(name, shader);
+		Add(StringId(name), shader);
 		return shader;
 	}
 	
-	Ref<Shader> ShaderLibrary::Get(const std::string& name)
+	Ref<Shader> ShaderLibrary::LoadAsync(const std::string& filepath)
+	{
+		auto shader = Shader::CreateAsync(filepath.c_str());
+		Add(shader);
+		m_Pending.push_back(shader);
+		return shader;
+	}
+
+	Ref<Shader> ShaderLibrary::LoadAsync(const std::string& name, const std::string& filepath)
+	{
+		auto shader = Shader::CreateAsync(filepath.c_str());
+		Add(StringId(name), shader);
+		m_Pending.push_back(shader);
+		return shader;
+	}
+
+	void ShaderLibrary::SubmitPending()
+	{
+		if (m_Pending.empty())
+			return;
+
+		JobSystem::ParallelFor((uint32_t)m_Pending.size(), 1, [](void* context, uint32_t begin, uint32_t end)
+			{
+				auto& pending = *(std::vector<Ref<Shader>>*)context;
+				for (uint32_t i = begin; i < end; i++)
+					pending[i]->LoadSources();
+			}, &m_Pending);
+
+		// Submitting everything before anything is waited on lets the driver's compiler threads overlap the work
+		for (auto& shader : m_Pending)
+			shader->Submit();
+		m_Pending.clear();
+	}
+
+	bool ShaderLibrary::IsReady() const
 	{
-		EG_CORE_ASSERT(Exists(name), "Shader not found!");
-		return m_Shaders[name];
+		for (auto& kv : m_Shaders)
+		{
+			if (!kv.second->IsReady())
+				return false;
+		}
+		return true;
 	}
-	bool ShaderLibrary::Exists(const std::string& name) const
+
+	const Ref<Shader>& ShaderLibrary::Get(StringId name) const
+	{
+		auto it = m_Shaders.find(name);
+		EG_CORE_ASSERT(it != m_Shaders.end(), "Shader not found!");
+		return it->second;
+	}
+	bool ShaderLibrary::Exists(StringId name) const
 	{
 		return m_Shaders.find(name) != m_Shaders.end();
 	}
+
+	ShaderVariants::ShaderVariants(const std::string& filepath)
+		: m_FilePath(filepath)
+	{
+	}
+
+	ShaderVariants::Variant& ShaderVariants::findOrCreate(const std::string& variantKey, const ShaderDefines& defines)
+	{
+		Variant& variant = m_Variants[variantKey];
+		if (!variant.Instance)
+			variant.Instance = Shader::CreateAsync(m_FilePath.c_str(), defines);
+		return variant;
+	}
+
+	const Ref<Shader>& ShaderVariants::Get(const ShaderDefines& defines)
+	{
+		std::string variantKey = ShaderPreprocessor::VariantKey(defines);
+		Variant& variant = findOrCreate(variantKey, defines);
+		if (!variant.Used)
+		{
+			variant.Used = true;
+			m_Used.push_back(variantKey);
+		}
+		return variant.Instance;
+	}
+
+	void ShaderVariants::Precompile(const std::vector<std::string>& variantKeys)
+	{
+		std::vector<Ref<Shader>> pending;
+		for (const std::string& variantKey : variantKeys)
+		{
+			if (m_Variants.find(variantKey) == m_Variants.end())
+				pending.push_back(findOrCreate(variantKey, ShaderPreprocessor::ParseVariantKey(variantKey)).Instance);
+		}
+
+		JobSystem::ParallelFor((uint32_t)pending.size(), 1, [](void* context, uint32_t begin, uint32_t end)
+			{
+				auto& pending = *(std::vector<Ref<Shader>>*)context;
+				for (uint32_t i = begin; i < end; i++)
+					pending[i]->LoadSources();
+			}, &pending);
+
+		for (auto& shader : pending)
+			shader->Submit();
+	}
+
+	bool ShaderVariants::SaveUsage(const std::string& path) const
+	{
+		std::error_code error;
+		std::filesystem::path parent = std::filesystem::path(path).parent_path();
+		if (!parent.empty())
+			std::filesystem::create_directories(parent, error);
+
+		std::ofstream file(path, std::ios::trunc);
+		if (!file)
+		{
+			EG_CORE_WARN("Unable to write shader variant usage to {0}", path);
+			return false;
+		}
+
+		for (const std::string& variantKey : m_Used)
+			file << variantKey << '\n';
+		return true;
+	}
+
+	std::vector<std::string> ShaderVariants::LoadUsage(const std::string& path)
+	{
+		std::vector<std::string> variantKeys;
+		std::ifstream file(path);
+		std::string line;
+		while (std::getline(file, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+			variantKeys.push_back(line);
+		}
+		return variantKeys;
+	}
 }
\ No newline at end of file
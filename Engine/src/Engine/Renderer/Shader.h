@@ -4,6 +4,10 @@
 #include <string>
 #include <glm/glm.hpp>
 
+#include "ShaderPreprocessor.h"
+#include "RenderCommand.h"
+#include "Engine/Core/StringId.h"
+
 namespace Engine
 {
 	using std::string;
@@ -12,14 +16,116 @@ namespace Engine
 	typedef unsigned int GLenum;
 	typedef unsigned int GLuint;
 
+	// Types of the uniforms a shader exposes through its uniform table. Booleans and samplers are set as Int.
+	enum class UniformType : uint8_t
+	{
+		None = 0, Int, UInt, Float, Float2, Float3, Float4, Mat3, Mat4
+	};
+
+	static uint32_t UniformTypeSize(UniformType type)
+	{
+		switch (type)
+		{
+		case UniformType::Int:		return 4;
+		case UniformType::UInt:		return 4;
+		case UniformType::Float:	return 4;
+		case UniformType::Float2:	return 4 * 2;
+		case UniformType::Float3:	return 4 * 3;
+		case UniformType::Float4:	return 4 * 4;
+		case UniformType::Mat3:		return 4 * 3 * 3;
+		case UniformType::Mat4:		return 4 * 4 * 4;
+		}
+		return 0;
+	}
+
+	template<typename T> struct UniformTypeOf { static constexpr UniformType Type = UniformType::None; };
+	template<> struct UniformTypeOf<int> { static constexpr UniformType Type = UniformType::Int; };
+	template<> struct UniformTypeOf<uint32_t> { static constexpr UniformType Type = UniformType::UInt; };
+	template<> struct UniformTypeOf<float> { static constexpr UniformType Type = UniformType::Float; };
+	template<> struct UniformTypeOf<glm::vec2> { static constexpr UniformType Type = UniformType::Float2; };
+	template<> struct UniformTypeOf<glm::vec3> { static constexpr UniformType Type = UniformType::Float3; };
+	template<> struct UniformTypeOf<glm::vec4> { static constexpr UniformType Type = UniformType::Float4; };
+	template<> struct UniformTypeOf<glm::mat3> { static constexpr UniformType Type = UniformType::Mat3; };
+	template<> struct UniformTypeOf<glm::mat4> { static constexpr UniformType Type = UniformType::Mat4; };
+
+	// An active uniform of a linked program; arrays are one entry named without the [0] suffix
+	struct UniformInfo
+	{
+		std::string Name;
+		UniformType Type = UniformType::None;
+		int Location = -1;
+		// Array size, 1 for plain uniforms
+		uint32_t Count = 1;
+		// Byte offset of the uniform's shadow copy
+		uint32_t Offset = 0;
+	};
+
+	// An active vertex input of a linked program
+	struct ShaderAttributeInfo
+	{
+		std::string Name;
+		int Location = -1;
+		// Matrices take one location per column; ComponentCount is per location
+		uint32_t LocationCount = 1;
+		uint32_t ComponentCount = 1;
+		// int and uint inputs have to be fed without conversion to float
+		bool Integer = false;
+	};
+
+	// An active uniform or shader storage block
+	struct ShaderBlockInfo
+	{
+		std::string Name;
+		uint32_t Binding = 0;
+		uint32_t Size = 0;
+	};
+
+	// Interface of a linked program, gathered once after linking
+	struct ShaderReflection
+	{
+		// Distinct for every link of every shader, a reload relinks with a new version
+		uint64_t Version = 0;
+		// Sorted by location
+		std::vector<ShaderAttributeInfo> Attributes;
+		// Indexed by the uniform indices of FindUniform and UniformHandle
+		std::vector<UniformInfo> Uniforms;
+		std::vector<ShaderBlockInfo> UniformBlocks;
+		std::vector<ShaderBlockInfo> StorageBlocks;
+	};
+
 	class Shader
 	{
 	public:
+		// Every engine shader declares the std140 SceneData block, which linking binds to this binding point
+		static constexpr const char* SceneDataBlockName = "SceneData";
+		static constexpr uint32_t SceneDataBinding = 0;
+
 		Shader() {}
 
 		virtual const std::string& GetName() const = 0;
+		// Source file of shaders loaded from a #type file, empty otherwise
+		virtual const std::string& GetFilePath() const = 0;
+
+		virtual void Bind() const = 0;
+		virtual void Unbind() const = 0;
+
+		// Steps of an asynchronous load, no-ops for shaders that are created ready.
+		// LoadSources reads the file and may run on any thread, Submit needs the context and never waits for the driver.
+		virtual void LoadSources() {}
+		virtual void Submit() {}
+		// False while the program is still being built; never blocks. Using the shader before then waits for it.
+		virtual bool IsReady() const { return true; }
+
+		// Hot reload, see HotReload. Reload starts rebuilding from the source file without waiting for anything;
+		// UpdateReload swaps the new program in once it has linked and returns true when the reload is over.
+		// Uniform values and UniformHandles carry over, a program that fails to build is discarded.
+		virtual void Reload() {}
+		virtual bool UpdateReload() { return true; }
 
 		static Ref<Shader> Create(const char* shaderFile);
+		// Returns right away, the file is read and compiled by ShaderLibrary::SubmitPending or on first use.
+		// defines select a permutation of the file, see ShaderVariants.
+		static Ref<Shader> CreateAsync(const char* shaderFile, const ShaderDefines& defines = ShaderDefines());
 		static Ref<Shader> Create(const char* vertexShaderFile, const char* fragmentShaderFile, const char* geometricShaderFile = nullptr);
 		static Ref<Shader> Create(int dummy, const char* shaderName, const char* vertexShaderCode, const char* fragmentShaderCode, const char* geometricShaderCode = nullptr);
 
@@ -28,6 +134,15 @@ namespace Engine
 		virtual void compile_debug(const char* vertexSource, const char* fragmentSource, const char* geometrySource) = 0;
 		virtual ~Shader() = default;
 
+		virtual const ShaderReflection& GetReflection() const = 0;
+		// Index of the named uniform in the reflected uniform table, -1 if the program has no such active uniform
+		virtual int FindUniform(StringId name) const = 0;
+		virtual const UniformInfo& GetUniformInfo(int index) const = 0;
+		// Uploads count array elements starting at firstElement, skipping the upload when the values match the shadow copy.
+		// data must point to values of the uniform's type.
+		virtual void SetUniform(int index, const void* data, uint32_t count = 1, uint32_t firstElement = 0) const = 0;
+
+		// The name based functions below look the name up on every call; code that runs per frame holds a UniformHandle
 		virtual int getUniformLocation(const string& name) const = 0;
 		virtual GLuint getUniformBlockIndex(const string& name) const = 0;
 		virtual GLuint getUniformBlockIndex(const string& listName, const string& memberName, const unsigned int& idx) const = 0;
@@ -106,19 +221,147 @@ namespace Engine
 		virtual void setMat4fv_vector(const string& listName, const string& memberName, const glm::mat4& mat, const unsigned int& size, bool transpose = false) const = 0;
 	};
 
+	// Typed reference to a uniform resolved once, uploads go straight to the cached location.
+	// The handle does not own the shader and must not outlive it.
+	template<typename T>
+	class UniformHandle
+	{
+	public:
+		UniformHandle() = default;
+		UniformHandle(const Shader& shader, StringId name)
+			: m_Shader(&shader), m_Index(shader.FindUniform(name))
+		{
+			EG_CORE_ASSERT(m_Index < 0 || shader.GetUniformInfo(m_Index).Type == UniformTypeOf<T>::Type, "Uniform type mismatch!");
+		}
+		UniformHandle(const Ref<Shader>& shader, StringId name)
+			: UniformHandle(*shader, name)
+		{
+		}
+
+		// False when the uniform is not active in the program, setting it is then a no-op like with glUniform
+		bool IsValid() const { return m_Index >= 0; }
+
+		// Calls the graphics API directly, so while recording for the render thread only inside RenderCommand::Submit functions
+		void Set(const T& value) const
+		{
+			RenderCommand::RequireContext("UniformHandle");
+			if (m_Index >= 0)
+				m_Shader->SetUniform(m_Index, &value);
+		}
+
+		void Set(const T* values, uint32_t count, uint32_t firstElement = 0) const
+		{
+			RenderCommand::RequireContext("UniformHandle");
+			if (m_Index >= 0)
+				m_Shader->SetUniform(m_Index, values, count, firstElement);
+		}
+	private:
+		const Shader* m_Shader = nullptr;
+		int m_Index = -1;
+	};
+
+	// A uniform of one name on whichever shader a renderer is handed. The handle is resolved once per
+	// linked program, the last few are kept by reflection version, so setting it only compares versions.
+	template<typename T>
+	class CachedUniform
+	{
+	public:
+		explicit constexpr CachedUniform(StringId name)
+			: m_Name(name)
+		{
+		}
+
+		const UniformHandle<T>& Get(const Shader& shader)
+		{
+			uint64_t version = shader.GetReflection().Version;
+			for (const Entry& entry : m_Entries)
+			{
+				if (entry.Version == version)
+					return entry.Handle;
+			}
+
+			// Versions are never reused, so an entry of a destroyed or relinked program simply ages out
+			Entry& entry = m_Entries[m_Next];
+			m_Next = (m_Next + 1) % EntryCount;
+			entry.Version = version;
+			entry.Handle = UniformHandle<T>(shader, m_Name);
+			return entry.Handle;
+		}
+
+		const UniformHandle<T>& Get(const Ref<Shader>& shader) { return Get(*shader); }
+
+		void Set(const Shader& shader, const T& value) { Get(shader).Set(value); }
+		void Set(const Ref<Shader>& shader, const T& value) { Get(*shader).Set(value); }
+	private:
+		static constexpr uint32_t EntryCount = 4;
+
+		struct Entry
+		{
+			// Zero is never the version of a linked program
+			uint64_t Version = 0;
+			UniformHandle<T> Handle;
+		};
+
+		StringId m_Name;
+		Entry m_Entries[EntryCount];
+		uint32_t m_Next = 0;
+	};
+
 	class ShaderLibrary
 	{
 	public:
-		void Add(const std::string& name, const Ref<Shader>& shader);
+		void Add(StringId name, const Ref<Shader>& shader);
 		void Add(const Ref<Shader>& shader);
 		Ref<Shader> Load(const std::string& filepath);
 		Ref<Shader> Load(const std::string& name, const std::string& filepath);
+		// Adds a shader that is built in the background, see Shader::IsReady. Loads queued together overlap:
+		// their files are read in parallel and the driver compiles them concurrently where it can.
+		Ref<Shader> LoadAsync(const std::string& filepath);
+		Ref<Shader> LoadAsync(const std::string& name, const std::string& filepath);
+		// Reads every queued file on the job system's workers, then hands all of them to the driver.
+		// Call it once per frame after queuing loads; a shader used before then is built on the spot.
+		void SubmitPending();
+		// True once every shader in the library has finished building; never blocks
+		bool IsReady() const;
 
-		Ref<Shader> Get(const std::string& name);
+		const Ref<Shader>& Get(StringId name) const;
 
-		bool Exists(const std::string& name) const;
+		bool Exists(StringId name) const;
 	private:
-		std::unordered_map<std::string, Ref<Shader>> m_Shaders;
+		std::unordered_map<StringId, Ref<Shader>> m_Shaders;
+		std::vector<Ref<Shader>> m_Pending;
+	};
+
+	// Permutations of one #type file, told apart by their #define sets. A permutation is created on the first
+	// Get and compiled when it is first used, so only the ones a run actually draws with are ever built.
+	class ShaderVariants
+	{
+	public:
+		ShaderVariants(const std::string& filepath);
+
+		// Builds the variant key on every call, hold on to the returned shader rather than calling this per draw
+		const Ref<Shader>& Get(const ShaderDefines& defines = ShaderDefines());
+
+		const std::string& GetFilePath() const { return m_FilePath; }
+		// Variant keys of the permutations requested through Get, in the order they were first requested
+		const std::vector<std::string>& GetUsedVariants() const { return m_Used; }
+
+		// Starts building the given permutations without waiting for them; linked programs go to the program binary cache
+		void Precompile(const std::vector<std::string>& variantKeys);
+		// Writes the used variant keys one per line, for Precompile on the next run
+		bool SaveUsage(const std::string& path) const;
+		static std::vector<std::string> LoadUsage(const std::string& path);
+	private:
+		struct Variant
+		{
+			Ref<Shader> Instance;
+			bool Used = false;
+		};
+		Variant& findOrCreate(const std::string& variantKey, const ShaderDefines& defines);
+
+		std::string m_FilePath;
+		std::unordered_map<std::string, Variant> m_Variants;
+		std::vector<std::string> m_Used;
 	};
 
 }
\ No newline at end of file
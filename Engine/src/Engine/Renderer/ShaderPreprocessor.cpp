@@ -0,0 +1,157 @@
+#include "engine_pch.h"
+#include "ShaderPreprocessor.h"
+
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+
+namespace Engine
+{
+	static bool ReadText(const std::string& filePath, std::string& text)
+	{
+		std::ifstream file(filePath, std::ios::in | std::ios::binary);
+		if (!file)
+			return false;
+
+		file.seekg(0, std::ios::end);
+		text.resize((size_t)file.tellg());
+		file.seekg(0, std::ios::beg);
+		file.read(&text[0], text.size());
+		return true;
+	}
+
+	// Path named by an #include line, empty if the line is not one
+	static std::string IncludedPath(const std::string& line)
+	{
+		size_t pos = line.find_first_not_of(" \t");
+		if (pos == std::string::npos || line.compare(pos, 8, "#include") != 0)
+			return std::string();
+
+		size_t open = line.find('"', pos + 8);
+		size_t close = open == std::string::npos ? std::string::npos : line.find('"', open + 1);
+		if (close == std::string::npos)
+			return std::string();
+		return line.substr(open + 1, close - open - 1);
+	}
+
+	static bool AppendFile(const std::filesystem::path& filePath, std::unordered_set<std::string>& included, std::vector<std::string>& includeStack, std::vector<std::string>& dependencies, std::string& output)
+	{
+		std::string text;
+		if (!ReadText(filePath.string(), text))
+			return false;
+
+		size_t lineStart = 0;
+		while (lineStart < text.size())
+		{
+			size_t lineEnd = text.find('\n', lineStart);
+			lineEnd = lineEnd == std::string::npos ? text.size() : lineEnd + 1;
+			std::string line = text.substr(lineStart, lineEnd - lineStart);
+			lineStart = lineEnd;
+
+			std::string includePath = IncludedPath(line);
+			if (includePath.empty())
+			{
+				// Every stage is compiled on its own and needs its own copy of shared files
+				if (includeStack.size() == 1 && line.compare(0, 5, "#type") == 0)
+					included = { includeStack.front() };
+				output += line;
+				continue;
+			}
+
+			std::filesystem::path resolved = (filePath.parent_path() / includePath).lexically_normal();
+			std::string key = resolved.generic_string();
+			if (std::find(includeStack.begin(), includeStack.end(), key) != includeStack.end())
+			{
+				EG_CORE_ERROR("Shader include cycle! {0} includes {1}", filePath.generic_string(), key);
+				continue;
+			}
+			if (!included.insert(key).second)
+				continue;
+			if (std::find(dependencies.begin(), dependencies.end(), key) == dependencies.end())
+				dependencies.push_back(key);
+
+			includeStack.push_back(key);
+			if (!AppendFile(resolved, included, includeStack, dependencies, output))
+				EG_CORE_ERROR("Unable to open shader include! {0} (from {1})", key, filePath.generic_string());
+			includeStack.pop_back();
+
+			if (!output.empty() && output.back() != '\n')
+				output += '\n';
+		}
+		return true;
+	}
+
+	std::string ShaderPreprocessor::ReadFile(const std::string& filePath, std::vector<std::string>* includes)
+	{
+		std::filesystem::path path = std::filesystem::path(filePath).lexically_normal();
+		std::unordered_set<std::string> included = { path.generic_string() };
+		std::vector<std::string> includeStack = { path.generic_string() };
+		std::vector<std::string> dependencies;
+
+		std::string output;
+		if (!AppendFile(path, included, includeStack, dependencies, output))
+			EG_CORE_ERROR("Unable to open shader file! {0}", filePath);
+		if (includes)
+			*includes = std::move(dependencies);
+		return output;
+	}
+
+	std::string ShaderPreprocessor::InjectDefines(const std::string& source, const ShaderDefines& defines)
+	{
+		if (defines.empty())
+			return source;
+
+		std::string lines;
+		for (auto& kv : defines)
+			lines += "#define " + kv.first + " " + kv.second + "\n";
+
+		// #version has to stay the first directive of the stage
+		size_t version = source.find("#version");
+		size_t insertAt = 0;
+		if (version != std::string::npos)
+		{
+			size_t eol = source.find('\n', version);
+			insertAt = eol == std::string::npos ? source.size() : eol + 1;
+		}
+
+		std::string result = source;
+		if (insertAt == result.size() && !result.empty() && result.back() != '\n')
+		{
+			result += '\n';
+			insertAt++;
+		}
+		result.insert(insertAt, lines);
+		return result;
+	}
+
+	std::string ShaderPreprocessor::VariantKey(const ShaderDefines& defines)
+	{
+		std::string key;
+		for (auto& kv : defines)
+		{
+			if (!key.empty())
+				key += ';';
+			key += kv.first + "=" + kv.second;
+		}
+		return key;
+	}
+
+	ShaderDefines ShaderPreprocessor::ParseVariantKey(const std::string& key)
+	{
+		ShaderDefines defines;
+		size_t begin = 0;
+		while (begin < key.size())
+		{
+			size_t end = key.find(';', begin);
+			end = end == std::string::npos ? key.size() : end;
+			std::string define = key.substr(begin, end - begin);
+			size_t equals = define.find('=');
+			if (equals == std::string::npos)
+				defines[define] = "";
+			else
+				defines[define.substr(0, equals)] = define.substr(equals + 1);
+			begin = end + 1;
+		}
+		return defines;
+	}
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Engine
+{
+	// #define name to value of one shader permutation; ordered so that equal sets give equal variant keys
+	using ShaderDefines = std::map<std::string, std::string>;
+
+	// Text-level preprocessing of shader files, done before the stages are split and compiled
+	class ShaderPreprocessor
+	{
+	public:
+		// Reads a file and splices in every #include "path" line, resolved relative to the including file.
+		// A file is included once per #type stage however often it is named, so shared declarations need no guards.
+		// Errors are logged; a file that cannot be read yields an empty string. includes receives the normalized
+		// path of every file named by an #include, including ones that could not be opened, without duplicates.
+		static std::string ReadFile(const std::string& filePath, std::vector<std::string>* includes = nullptr);
+
+		// Adds a #define line per entry right after the #version directive of a stage's source
+		static std::string InjectDefines(const std::string& source, const ShaderDefines& defines);
+
+		// Canonical text of a define set, "NAME=VALUE;..." in name order, empty for no defines
+		static std::string VariantKey(const ShaderDefines& defines);
+		static ShaderDefines ParseVariantKey(const std::string& key);
+	};
+}
@@ -0,0 +1,25 @@
+#include "engine_pch.h"
+#include "StreamingBuffer.h"
+#include "Platform/OpenGL/OpenGLStreamingBuffer.h"
+
+#include "Renderer.h"
+
+namespace Engine
+{
+	StreamingBuffer* StreamingBuffer::Create(uint32_t regionSize, uint32_t regionCount)
+	{
+		RenderCommand::RequireContext("StreamingBuffer");
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			EG_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+			return nullptr;
+			break;
+		case RendererAPI::API::OpenGL:
+			return new OpenGLStreamingBuffer(regionSize, regionCount);
+			break;
+		}
+		EG_CORE_ASSERT(false, "RendererAPI case is currently not supported!");
+		return nullptr;
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Engine/Renderer/Buffer.h"
+
+namespace Engine
+{
+	// A vertex buffer that stays mapped for its whole lifetime and is written from the CPU every frame.
+	// The storage is split into regions that are used as a ring; a region is only reused once the GPU
+	// has finished reading it, so writes never stall on the driver or force a copy.
+	//
+	// Data written through BeginWrite/EndWrite does not start at offset 0: draw it with the base vertex
+	// returned by GetBaseVertex().
+	class StreamingBuffer : public VertexBuffer
+	{
+	public:
+		virtual ~StreamingBuffer() {}
+
+		// Returns a write pointer to size bytes, aligned to the layout stride. If the current region is
+		// full the buffer moves on to the next one, waiting for the GPU if it is still in use.
+		virtual void* BeginWrite(uint32_t size) = 0;
+		virtual void EndWrite(uint32_t bytesWritten) = 0;
+
+		// Byte offset and first vertex of the data written by the last BeginWrite
+		virtual uint32_t GetWriteOffset() const = 0;
+		virtual uint32_t GetBaseVertex() const = 0;
+
+		// Call after the draws reading the current region have been issued
+		virtual void EndFrame() = 0;
+
+		virtual uint32_t GetRegionSize() const = 0;
+		virtual uint32_t GetRegionCount() const = 0;
+
+		static StreamingBuffer* Create(uint32_t regionSize, uint32_t regionCount = 3);
+	};
+}
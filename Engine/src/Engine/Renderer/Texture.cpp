@@ -2,19 +2,37 @@
 #include "Texture.h"
 
 #include "Renderer.h"
+#include "HotReload.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
 
 namespace Engine
 {
-	Ref<Texture2D> Texture2D::Create(const char* path)
+	Ref<Texture2D> Texture2D::Create(uint32_t width, uint32_t height, TextureFilter magFilter)
 	{
+		RenderCommand::RequireContext("Texture2D");
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::OpenGL:
-			return std::make_shared<OpenGLTexture2D>(path);
+			return std::make_shared<OpenGLTexture2D>(width, height, magFilter);
 			break;
 		}
 		EG_CORE_ASSERT(false, "RendererAPI case is currently not supported!");
 		return nullptr;
 	}
+
+	Ref<Texture2D> Texture2D::Create(const char* path)
+	{
+		RenderCommand::RequireContext("Texture2D");
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::OpenGL:
+		{
+			Ref<Texture2D> texture = std::make_shared<OpenGLTexture2D>(path);
+			HotReload::Register(texture);
+			return texture;
+		}
+		}
+		EG_CORE_ASSERT(false, "RendererAPI case is currently not supported!");
+		return nullptr;
+	}
 }
\ No newline at end of file
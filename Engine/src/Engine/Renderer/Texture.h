@@ -4,6 +4,11 @@
 
 namespace Engine
 {
+	enum class TextureFilter
+	{
+		Nearest = 0, Linear
+	};
+
 	class Texture
 	{
 	public:
@@ -11,12 +16,30 @@ namespace Engine
 
 		virtual uint32_t GetWidth() const = 0;
 		virtual uint32_t GetHeight() const = 0;
+		virtual uint32_t GetRendererID() const = 0;
+
+		virtual void SetData(void* data, uint32_t size) = 0;
+
 		virtual void Bind(uint32_t slot = 0) const = 0;
+
+		virtual bool operator==(const Texture& other) const = 0;
 	};
 
 	class Texture2D : public Texture
 	{
 	public:
+		// magFilter picks how the texture is sampled when magnified; it is always filtered linearly when minified
+		static Ref<Texture2D> Create(uint32_t width, uint32_t height, TextureFilter magFilter = TextureFilter::Nearest);
 		static Ref<Texture2D> Create(const char* path);
+
+		// Image file of textures created from a path, empty otherwise
+		virtual const std::string& GetPath() const = 0;
+
+		// Hot reload, see HotReload. Reload decodes the file in the background; UpdateReload uploads
+		// the image once it is decoded and returns true when the reload is over. An image of another size
+		// or channel count gets a new texture object, so GetRendererID changes: IDs kept across frames,
+		// such as ImGui image IDs, have to be fetched again rather than cached.
+		virtual void Reload() {}
+		virtual bool UpdateReload() { return true; }
 	};
 }
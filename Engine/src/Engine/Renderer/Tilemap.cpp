@@ -0,0 +1,164 @@
+#include "engine_pch.h"
+#include "Tilemap.h"
+
+#include "RenderCommand.h"
+#include "Renderer.h"
+
+namespace Engine
+{
+	struct TileVertex
+	{
+		glm::vec3 Position;
+		glm::vec2 TexCoord;
+	};
+
+	// Shared by every tilemap alive
+	static std::weak_ptr<Shader> s_TilemapShader;
+
+	Tilemap::Tilemap(uint32_t width, uint32_t height, const Ref<Texture2D>& tileset, uint32_t tilesetColumns, uint32_t tilesetRows, const glm::vec3& origin, float tileSize, uint32_t chunkSize)
+		:m_Width(width), m_Height(height), m_ChunkSize(chunkSize), m_Origin(origin), m_TileSize(tileSize),
+		m_Tileset(tileset), m_TilesetColumns(tilesetColumns), m_TilesetRows(tilesetRows), m_Tiles((size_t)width * height, EmptyTile)
+	{
+		EG_CORE_ASSERT(chunkSize > 0 && tilesetColumns > 0 && tilesetRows > 0, "Invalid tilemap dimensions!");
+
+		m_ChunksX = (width + chunkSize - 1) / chunkSize;
+		m_ChunksY = (height + chunkSize - 1) / chunkSize;
+		m_Chunks.resize((size_t)m_ChunksX * m_ChunksY);
+
+		float chunkExtent = chunkSize * tileSize;
+		for (uint32_t y = 0; y < m_ChunksY; y++)
+		{
+			for (uint32_t x = 0; x < m_ChunksX; x++)
+			{
+				Chunk& chunk = GetChunk(x, y);
+				chunk.Min = { origin.x + x * chunkExtent, origin.y + y * chunkExtent };
+				chunk.Max = { chunk.Min.x + chunkExtent, chunk.Min.y + chunkExtent };
+			}
+		}
+
+		m_Shader = s_TilemapShader.lock();
+		if (!m_Shader)
+		{
+			m_Shader = Shader::Create("assets/shaders/tilemapShader.glsl");
+			s_TilemapShader = m_Shader;
+		}
+		m_TextureUniform = UniformHandle<int>(m_Shader, "u_Texture"_sid);
+		m_IndexBuffer = IndexBuffer::GetQuadIndexBuffer(chunkSize * chunkSize);
+	}
+
+	uint16_t Tilemap::GetTile(uint32_t x, uint32_t y) const
+	{
+		EG_CORE_ASSERT(x < m_Width && y < m_Height, "Tile out of range!");
+		return m_Tiles[(size_t)y * m_Width + x];
+	}
+
+	void Tilemap::SetTile(uint32_t x, uint32_t y, uint16_t tile)
+	{
+		EG_CORE_ASSERT(x < m_Width && y < m_Height, "Tile out of range!");
+		uint16_t& current = m_Tiles[(size_t)y * m_Width + x];
+		if (current == tile)
+			return;
+		current = tile;
+		GetChunk(x / m_ChunkSize, y / m_ChunkSize).Dirty = true;
+	}
+
+	void Tilemap::Fill(uint16_t tile)
+	{
+		std::fill(m_Tiles.begin(), m_Tiles.end(), tile);
+		for (Chunk& chunk : m_Chunks)
+			chunk.Dirty = true;
+	}
+
+	void Tilemap::RebuildChunk(uint32_t chunkX, uint32_t chunkY)
+	{
+		Chunk& chunk = GetChunk(chunkX, chunkY);
+
+		uint32_t firstX = chunkX * m_ChunkSize;
+		uint32_t firstY = chunkY * m_ChunkSize;
+		uint32_t lastX = std::min(firstX + m_ChunkSize, m_Width);
+		uint32_t lastY = std::min(firstY + m_ChunkSize, m_Height);
+
+		std::vector<TileVertex> vertices;
+		vertices.reserve((size_t)(lastX - firstX) * (lastY - firstY) * 4);
+
+		glm::vec2 cellSize = { 1.f / m_TilesetColumns, 1.f / m_TilesetRows };
+		for (uint32_t y = firstY; y < lastY; y++)
+		{
+			for (uint32_t x = firstX; x < lastX; x++)
+			{
+				uint16_t tile = m_Tiles[(size_t)y * m_Width + x];
+				if (tile == EmptyTile)
+					continue;
+
+				// Textures are loaded flipped, so the top row of the image is at v = 1
+				uint32_t column = tile % m_TilesetColumns;
+				uint32_t row = tile / m_TilesetColumns;
+				glm::vec2 uvMin = { column * cellSize.x, 1.f - (row + 1) * cellSize.y };
+				glm::vec2 uvMax = { uvMin.x + cellSize.x, uvMin.y + cellSize.y };
+
+				glm::vec3 min = { m_Origin.x + x * m_TileSize, m_Origin.y + y * m_TileSize, m_Origin.z };
+				glm::vec3 max = { min.x + m_TileSize, min.y + m_TileSize, m_Origin.z };
+
+				vertices.push_back({ { min.x, min.y, min.z }, { uvMin.x, uvMin.y } });
+				vertices.push_back({ { max.x, min.y, min.z }, { uvMax.x, uvMin.y } });
+				vertices.push_back({ { max.x, max.y, min.z }, { uvMax.x, uvMax.y } });
+				vertices.push_back({ { min.x, max.y, min.z }, { uvMin.x, uvMax.y } });
+			}
+		}
+
+		if (!chunk.Geometry)
+		{
+			chunk.Vertices.reset(VertexBuffer::Create(m_ChunkSize * m_ChunkSize * 4 * sizeof(TileVertex)));
+			chunk.Vertices->SetLayout({
+				{ShaderDataType::Float3, "a_Position"},
+				{ShaderDataType::Float2, "a_TexCoord"},
+			});
+			chunk.Geometry = VertexArray::Create();
+			chunk.Geometry->AddVertexBuffer(chunk.Vertices);
+			chunk.Geometry->SetIndexBuffer(m_IndexBuffer);
+		}
+		if (!vertices.empty())
+			chunk.Vertices->SetData(vertices.data(), (uint32_t)(vertices.size() * sizeof(TileVertex)));
+
+		chunk.IndexCount = (uint32_t)(vertices.size() / 4 * 6);
+		chunk.Dirty = false;
+		m_Stats.ChunksRebuilt++;
+	}
+
+	void Tilemap::Render(const OrthographicCamera& camera)
+	{
+		RenderCommand::RequireContext("Tilemap");
+		m_Stats = Statistics();
+		const OrthographicCamera::Bounds& bounds = camera.GetVisibleBounds();
+
+		Renderer::SetSceneCamera(camera);
+		m_Shader->Bind();
+		m_TextureUniform.Set(0);
+		m_Tileset->Bind(0);
+
+		RenderCommand::SetDepthTest(true);
+		for (uint32_t y = 0; y < m_ChunksY; y++)
+		{
+			for (uint32_t x = 0; x < m_ChunksX; x++)
+			{
+				Chunk& chunk = GetChunk(x, y);
+				if (chunk.Max.x < bounds.Min.x || chunk.Min.x > bounds.Max.x || chunk.Max.y < bounds.Min.y || chunk.Min.y > bounds.Max.y)
+				{
+					m_Stats.ChunksCulled++;
+					continue;
+				}
+
+				if (chunk.Dirty)
+					RebuildChunk(x, y);
+				if (chunk.IndexCount == 0)
+					continue;
+
+				chunk.Geometry->Bind();
+				chunk.Geometry->ValidateLayout(*m_Shader);
+				RenderCommand::DrawIndexed(chunk.Geometry, chunk.IndexCount);
+				m_Stats.DrawCalls++;
+			}
+		}
+		RenderCommand::SetDepthTest(false);
+	}
+}
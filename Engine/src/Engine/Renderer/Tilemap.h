@@ -0,0 +1,74 @@
+#pragma once
+#include "OrthographicCamera.h"
+#include "Texture.h"
+#include "VertexArray.h"
+#include "Shader.h"
+
+namespace Engine
+{
+	// A static grid of tiles drawn from a tileset texture laid out as a uniform grid.
+	//
+	// The map is split into square chunks whose geometry is baked into their own vertex array once.
+	// SetTile only marks the owning chunk dirty; it is rebuilt the next time it is visible. Each visible,
+	// non-empty chunk is one draw call, so an unchanged map costs a bounds test per chunk per frame.
+	class Tilemap
+	{
+	public:
+		static constexpr uint16_t EmptyTile = 0xffff;
+
+		// Tiles are tileSize world units wide, tile (0, 0) is the lower left one and sits at origin.
+		// Tile ids count the tileset cells row by row, starting at the top left of the image.
+		Tilemap(uint32_t width, uint32_t height, const Ref<Texture2D>& tileset, uint32_t tilesetColumns, uint32_t tilesetRows,
+			const glm::vec3& origin = glm::vec3(0.f), float tileSize = 1.f, uint32_t chunkSize = 32);
+
+		uint32_t GetWidth() const { return m_Width; }
+		uint32_t GetHeight() const { return m_Height; }
+
+		uint16_t GetTile(uint32_t x, uint32_t y) const;
+		void SetTile(uint32_t x, uint32_t y, uint16_t tile);
+		void Fill(uint16_t tile);
+
+		// Draws the chunks overlapping the camera bounds, depth testing against what is already drawn
+		void Render(const OrthographicCamera& camera);
+
+		// Counters of the last Render call
+		struct Statistics
+		{
+			uint32_t DrawCalls = 0;
+			uint32_t ChunksCulled = 0;
+			uint32_t ChunksRebuilt = 0;
+		};
+		const Statistics& GetStats() const { return m_Stats; }
+	private:
+		struct Chunk
+		{
+			Ref<VertexArray> Geometry;
+			Ref<VertexBuffer> Vertices;
+			uint32_t IndexCount = 0;
+			bool Dirty = true;
+			glm::vec2 Min;
+			glm::vec2 Max;
+		};
+
+		void RebuildChunk(uint32_t chunkX, uint32_t chunkY);
+		Chunk& GetChunk(uint32_t chunkX, uint32_t chunkY) { return m_Chunks[chunkY * m_ChunksX + chunkX]; }
+	private:
+		uint32_t m_Width, m_Height;
+		uint32_t m_ChunkSize;
+		uint32_t m_ChunksX, m_ChunksY;
+		glm::vec3 m_Origin;
+		float m_TileSize;
+
+		Ref<Texture2D> m_Tileset;
+		uint32_t m_TilesetColumns, m_TilesetRows;
+		Ref<Shader> m_Shader;
+		// Uniform indices survive hot reloads, so the handle is resolved once
+		UniformHandle<int> m_TextureUniform;
+		// Every chunk shares one index buffer sized for a full chunk
+		Ref<IndexBuffer> m_IndexBuffer;
+
+		std::vector<uint16_t> m_Tiles;
+		std::vector<Chunk> m_Chunks;
+		Statistics m_Stats;
+	};
+}
@@ -1,6 +1,7 @@
 #include "engine_pch.h"
 #include "VertexArray.h"
 #include "Renderer.h"
+#include "Shader.h"
 
 #include "Platform/OpenGL/OpenGLVertexArray.h"
 
@@ -8,6 +9,7 @@ namespace Engine
 {
 	Ref<VertexArray> VertexArray::Create()
 	{
+		RenderCommand::RequireContext("VertexArray");
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::OpenGL:
@@ -17,4 +19,84 @@ namespace Engine
 		EG_CORE_ASSERT(false, "RendererAPI case is currently not supported!");
 		return nullptr;
 	}
+
+	bool VertexArray::ValidateLayout(const Shader& shader)
+	{
+		const ShaderReflection& reflection = shader.GetReflection();
+		auto validated = std::find_if(m_ValidatedShaders.begin(), m_ValidatedShaders.end(), [&shader](const ValidatedShader& entry) { return entry.Program == &shader; });
+		if (validated != m_ValidatedShaders.end() && validated->Version == reflection.Version)
+			return validated->Valid;
+
+		// What the buffers feed to every location
+		struct LocationSource
+		{
+			const BufferElement* Element;
+			uint32_t ComponentCount;
+			bool Read;
+		};
+		std::vector<LocationSource> locations;
+		for (auto& vertexBuffer : GetVertexBuffers())
+		{
+			for (const auto& element : vertexBuffer->GetLayout())
+			{
+				uint32_t locationCount = element.GetLocationCount();
+				for (uint32_t column = 0; column < locationCount; column++)
+					locations.push_back({ &element, element.GetComponentCount() / locationCount, false });
+			}
+		}
+
+		bool valid = true;
+		for (const ShaderAttributeInfo& attribute : reflection.Attributes)
+		{
+			for (uint32_t column = 0; column < attribute.LocationCount; column++)
+			{
+				uint32_t location = attribute.Location + column;
+				if (location >= locations.size())
+				{
+					EG_CORE_ERROR("Shader {0} reads {1} from location {2}, which no vertex buffer feeds", shader.GetName(), attribute.Name, location);
+					valid = false;
+					continue;
+				}
+
+				LocationSource& source = locations[location];
+				source.Read = true;
+				if (column)
+					continue;
+
+				const BufferElement& element = *source.Element;
+				if (element.IsInteger() != attribute.Integer)
+				{
+					// Integers fed to float inputs or floats fed to integer inputs arrive as garbage
+					EG_CORE_ERROR("Shader {0} reads {1} as {2}, but the layout feeds {3} as {4}", shader.GetName(), attribute.Name,
+						attribute.Integer ? "integers" : "floats", element.Name, element.IsInteger() ? "integers" : "floats");
+					valid = false;
+				}
+				else if (source.ComponentCount > attribute.ComponentCount)
+					EG_CORE_WARN("Layout element {0} fetches {1} components, shader {2} only reads {3}", element.Name, source.ComponentCount, shader.GetName(), attribute.ComponentCount);
+
+				if (element.Name != attribute.Name)
+					EG_CORE_WARN("Layout element {0} feeds input {1} of shader {2}, the layout may be out of order", element.Name, attribute.Name, shader.GetName());
+			}
+		}
+
+		for (size_t location = 0; location < locations.size(); location++)
+		{
+			const LocationSource& source = locations[location];
+			if (!source.Read && (location == 0 || locations[location - 1].Element != source.Element))
+				EG_CORE_WARN("Layout element {0} is fetched but never read by shader {1}", source.Element->Name, shader.GetName());
+		}
+
+		if (validated != m_ValidatedShaders.end())
+		{
+			validated->Version = reflection.Version;
+			validated->Valid = valid;
+		}
+		else
+		{
+			if (m_ValidatedShaders.size() == MaxValidatedShaders)
+				m_ValidatedShaders.erase(m_ValidatedShaders.begin());
+			m_ValidatedShaders.push_back({ &shader, reflection.Version, valid });
+		}
+		return valid;
+	}
 }
@@ -4,6 +4,8 @@
 
 namespace Engine
 {
+	class Shader;
+
 	class VertexArray
 	{
 	public:
@@ -18,6 +20,22 @@ namespace Engine
 		virtual std::vector<Ref<VertexBuffer>>& GetVertexBuffers() = 0;
 		virtual Ref<IndexBuffer>& GetIndexBuffer() = 0;
 
+		// Checks that the vertex buffers feed every input of the shader with a matching type, attribute locations
+		// being assigned in order across the buffers. Mismatches are logged; each link of a shader is checked once,
+		// later calls only look up the result.
+		bool ValidateLayout(const Shader& shader);
+
 		static Ref<VertexArray> Create();
+	protected:
+		struct ValidatedShader
+		{
+			const Shader* Program;
+			// Reflection version the result is for, a relink replaces the entry
+			uint64_t Version;
+			bool Valid;
+		};
+		// One entry per shader checked, at most MaxValidatedShaders of the latest; adding a buffer clears it
+		static constexpr size_t MaxValidatedShaders = 8;
+		std::vector<ValidatedShader> m_ValidatedShaders;
 	};
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 
 namespace Engine
 {
+	class GraphicsContext;
+
 	struct WindowProps
 	{
 		std::string Title;
@@ -25,7 +27,10 @@ namespace Engine
 		using EventCallbackFn = std::function<void(Event&)>;
 
 		~Window() {}
+		// Polls events and presents the frame
 		virtual void OnUpdate() = 0;
+		// Only polls events, for when a render thread presents frames
+		virtual void PollEvents() = 0;
 
 		virtual unsigned int GetWidth() const  = 0;
 		virtual unsigned int GetHeight() const = 0;
@@ -36,6 +41,7 @@ namespace Engine
 		virtual bool IsVSync() const = 0;
 
 		virtual void* GetNativeWindow() const = 0;
+		virtual GraphicsContext* GetContext() const = 0;
 
 		static Window* Create(const WindowProps& props = WindowProps());
 	};
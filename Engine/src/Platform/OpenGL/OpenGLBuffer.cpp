@@ -1,53 +1,178 @@
 #include "engine_pch.h"
 #include "OpenGLBuffer.h"
+#include "OpenGLStateCache.h"
 #include <glad/glad.h>
 
 namespace Engine
 {
+	OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size)
+	{
+		glGenBuffers(1, &m_ID);
+		OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_ID);
+
+		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+	}
+
 	OpenGLVertexBuffer::OpenGLVertexBuffer(float* vertices, uint32_t size)
 	{
 		glGenBuffers(1, &m_ID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_ID);
+		OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_ID);
 
 		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
 	}
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
 	{
+		OpenGLStateCache::OnBufferDeleted(m_ID);
 		glDeleteBuffers(1, &m_ID);
 	}
 
 	void OpenGLVertexBuffer::Bind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_ID);
+		OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_ID);
 	}
 
 	void OpenGLVertexBuffer::Unbind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
-	OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* indices, uint32_t count)
-		:m_count(count)
+	void OpenGLVertexBuffer::SetData(const void* data, uint32_t size)
+	{
+		OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_ID);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+	}
+
+	OpenGLIndexBuffer::OpenGLIndexBuffer(const void* indices, uint32_t count, IndexType type)
+		:m_count(count), m_Type(type)
 	{
 		glGenBuffers(1, &m_ID);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ID);
+		OpenGLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ID);
 
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t) * count, indices, GL_STATIC_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, IndexTypeSize(type) * count, indices, GL_STATIC_DRAW);
 	}
 	
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
 	{
+		OpenGLStateCache::OnBufferDeleted(m_ID);
 		glDeleteBuffers(1, &m_ID);
 	}
 
 	void OpenGLIndexBuffer::Bind() const
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ID);
+		OpenGLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ID);
 	}
 
 	void OpenGLIndexBuffer::Unbind() const
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		OpenGLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+
+	// Storage is immutable in size but stays updatable with glNamedBufferSubData
+	static uint32_t CreateStorage(uint32_t size, const void* data)
+	{
+		uint32_t id;
+		glCreateBuffers(1, &id);
+		glNamedBufferStorage(id, size, data, GL_DYNAMIC_STORAGE_BIT);
+		return id;
+	}
+
+	static void ClearStorage(uint32_t id, uint32_t offset, uint32_t size)
+	{
+		EG_CORE_ASSERT(offset % 4 == 0 && size % 4 == 0, "Buffer clears must be 4-byte aligned!");
+		glClearNamedBufferSubData(id, GL_R32UI, offset, size, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+	}
+
+	OpenGLShaderStorageBuffer::OpenGLShaderStorageBuffer(uint32_t size, const void* data)
+		:m_ID(CreateStorage(size, data)), m_Size(size)
+	{
+	}
+
+	OpenGLShaderStorageBuffer::~OpenGLShaderStorageBuffer()
+	{
+		OpenGLStateCache::OnBufferDeleted(m_ID);
+		glDeleteBuffers(1, &m_ID);
+	}
+
+	void OpenGLShaderStorageBuffer::BindBase(uint32_t binding) const
+	{
+		OpenGLStateCache::BindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_ID);
+	}
+
+	void OpenGLShaderStorageBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		glNamedBufferSubData(m_ID, offset, size, data);
+	}
+
+	void OpenGLShaderStorageBuffer::ClearData(uint32_t offset, uint32_t size)
+	{
+		ClearStorage(m_ID, offset, size);
+	}
+
+	void OpenGLShaderStorageBuffer::GetData(void* data, uint32_t size, uint32_t offset) const
+	{
+		glGetNamedBufferSubData(m_ID, offset, size, data);
+	}
+
+	OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t size, const void* data)
+		:m_ID(CreateStorage(size, data)), m_Size(size)
+	{
+	}
+
+	OpenGLUniformBuffer::~OpenGLUniformBuffer()
+	{
+		OpenGLStateCache::OnBufferDeleted(m_ID);
+		glDeleteBuffers(1, &m_ID);
+	}
+
+	void OpenGLUniformBuffer::BindBase(uint32_t binding) const
+	{
+		OpenGLStateCache::BindBufferBase(GL_UNIFORM_BUFFER, binding, m_ID);
+	}
+
+	void OpenGLUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		glNamedBufferSubData(m_ID, offset, size, data);
+	}
+
+	OpenGLIndirectBuffer::OpenGLIndirectBuffer(uint32_t size, const void* data)
+		:m_ID(CreateStorage(size, data)), m_Size(size)
+	{
+	}
+
+	OpenGLIndirectBuffer::~OpenGLIndirectBuffer()
+	{
+		OpenGLStateCache::OnBufferDeleted(m_ID);
+		glDeleteBuffers(1, &m_ID);
+	}
+
+	void OpenGLIndirectBuffer::Bind() const
+	{
+		OpenGLStateCache::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_ID);
+	}
+
+	void OpenGLIndirectBuffer::Unbind() const
+	{
+		OpenGLStateCache::BindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+
+	void OpenGLIndirectBuffer::BindBase(uint32_t binding) const
+	{
+		OpenGLStateCache::BindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_ID);
+	}
+
+	void OpenGLIndirectBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		glNamedBufferSubData(m_ID, offset, size, data);
+	}
+
+	void OpenGLIndirectBuffer::ClearData(uint32_t offset, uint32_t size)
+	{
+		ClearStorage(m_ID, offset, size);
+	}
+
+	void OpenGLIndirectBuffer::GetData(void* data, uint32_t size, uint32_t offset) const
+	{
+		glGetNamedBufferSubData(m_ID, offset, size, data);
 	}
 }
\ No newline at end of file
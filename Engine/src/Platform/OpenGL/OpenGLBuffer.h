@@ -6,12 +6,15 @@ namespace Engine
 	class OpenGLVertexBuffer : public VertexBuffer
 	{
 	public:
+		OpenGLVertexBuffer(uint32_t size);
 		OpenGLVertexBuffer(float* vertices, uint32_t size);
 		virtual ~OpenGLVertexBuffer();
 
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
 
+		virtual void SetData(const void* data, uint32_t size) override;
+
 		virtual void SetLayout(const BufferLayout& layout) override { m_layout = layout; }
 		virtual const BufferLayout& GetLayout() const override { return m_layout; }
 	private:
@@ -22,15 +25,71 @@ namespace Engine
 	class OpenGLIndexBuffer : public IndexBuffer
 	{
 	public:
-		OpenGLIndexBuffer(uint32_t* indices, uint32_t count);
+		OpenGLIndexBuffer(const void* indices, uint32_t count, IndexType type);
 		virtual ~OpenGLIndexBuffer();
 
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
 
 		virtual uint32_t GetCount() const override { return m_count; }
+		virtual IndexType GetIndexType() const override { return m_Type; }
 	private:
 		uint32_t m_ID;
 		uint32_t m_count;
+		IndexType m_Type;
+	};
+
+	class OpenGLShaderStorageBuffer : public ShaderStorageBuffer
+	{
+	public:
+		OpenGLShaderStorageBuffer(uint32_t size, const void* data);
+		virtual ~OpenGLShaderStorageBuffer();
+
+		virtual void BindBase(uint32_t binding) const override;
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+		virtual void ClearData(uint32_t offset, uint32_t size) override;
+		virtual void GetData(void* data, uint32_t size, uint32_t offset = 0) const override;
+
+		virtual uint32_t GetSize() const override { return m_Size; }
+	private:
+		uint32_t m_ID;
+		uint32_t m_Size;
+	};
+
+	class OpenGLUniformBuffer : public UniformBuffer
+	{
+	public:
+		OpenGLUniformBuffer(uint32_t size, const void* data);
+		virtual ~OpenGLUniformBuffer();
+
+		virtual void BindBase(uint32_t binding) const override;
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+
+		virtual uint32_t GetSize() const override { return m_Size; }
+	private:
+		uint32_t m_ID;
+		uint32_t m_Size;
+	};
+
+	class OpenGLIndirectBuffer : public IndirectBuffer
+	{
+	public:
+		OpenGLIndirectBuffer(uint32_t size, const void* data);
+		virtual ~OpenGLIndirectBuffer();
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+		virtual void BindBase(uint32_t binding) const override;
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+		virtual void ClearData(uint32_t offset, uint32_t size) override;
+		virtual void GetData(void* data, uint32_t size, uint32_t offset = 0) const override;
+
+		virtual uint32_t GetSize() const override { return m_Size; }
+	private:
+		uint32_t m_ID;
+		uint32_t m_Size;
 	};
 }
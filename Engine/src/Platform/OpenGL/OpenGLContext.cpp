@@ -22,10 +22,22 @@ namespace Engine
 		EG_CORE_INFO("Vendor: {0}", glGetString(GL_VENDOR));
 		EG_CORE_INFO("Renderer: {0}", glGetString(GL_RENDERER));
 		EG_CORE_INFO("Version: {0}", glGetString(GL_VERSION));
+
+		EG_CORE_ASSERT(GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 6), "The renderer requires OpenGL 4.6!");
 	}
 
 	void OpenGLContext::SwapBuffers()
 	{
 		glfwSwapBuffers(m_windowHandle);
 	}
+
+	void OpenGLContext::MakeCurrent()
+	{
+		glfwMakeContextCurrent(m_windowHandle);
+	}
+
+	void OpenGLContext::ReleaseCurrent()
+	{
+		glfwMakeContextCurrent(nullptr);
+	}
 }
\ No newline at end of file
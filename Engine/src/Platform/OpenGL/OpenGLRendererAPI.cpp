@@ -1,17 +1,26 @@
 #include "engine_pch.h"
 #include "OpenGLRendererAPI.h"
+#include "OpenGLStateCache.h"
+#include "Engine/Renderer/RenderCommandQueue.h"
 #include <glad/glad.h>
 namespace Engine
 {
 	void OpenGLRendererAPI::Init()
 	{
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		OpenGLStateCache::Invalidate();
+		OpenGLStateCache::SetBlend(true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		// Equal depth passes so coplanar geometry keeps submission order
+		glDepthFunc(GL_LEQUAL);
+
+		int maxTextureUnits;
+		glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxTextureUnits);
+		m_MaxTextureSlots = (uint32_t)maxTextureUnits;
 	}
 
 	void OpenGLRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 	{
-		glViewport(x, y, width, height);
+		OpenGLStateCache::SetViewport(x, y, width, height);
 	}
 
 	void OpenGLRendererAPI::SetClearColor(const glm::vec4& color)
@@ -24,8 +33,211 @@ namespace Engine
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	}
 
-	void OpenGLRendererAPI::DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray)
+	void OpenGLRendererAPI::SetBlendMode(BlendMode mode)
+	{
+		switch (mode)
+		{
+		case BlendMode::Opaque:
+			OpenGLStateCache::SetBlend(false);
+			break;
+		case BlendMode::Alpha:
+			OpenGLStateCache::SetBlend(true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			break;
+		case BlendMode::Additive:
+			OpenGLStateCache::SetBlend(true, GL_SRC_ALPHA, GL_ONE);
+			break;
+		}
+	}
+
+	void OpenGLRendererAPI::SetDepthTest(bool enabled)
+	{
+		OpenGLStateCache::SetDepthTest(enabled);
+	}
+
+	void OpenGLRendererAPI::SetDepthWrite(bool enabled)
+	{
+		OpenGLStateCache::SetDepthWrite(enabled);
+	}
+
+	static GLenum IndexTypeToOpenGLType(IndexType type)
+	{
+		return type == IndexType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	}
+
+	static void DrawElements(VertexArray& vertexArray, uint32_t indexCount, uint32_t baseVertex)
+	{
+		const auto& indexBuffer = vertexArray.GetIndexBuffer();
+		uint32_t count = indexCount ? indexCount : indexBuffer->GetCount();
+		GLenum type = IndexTypeToOpenGLType(indexBuffer->GetIndexType());
+		if (baseVertex)
+			glDrawElementsBaseVertex(GL_TRIANGLES, count, type, nullptr, baseVertex);
+		else
+			glDrawElements(GL_TRIANGLES, count, type, nullptr);
+	}
+
+	static void DrawElementsInstanced(VertexArray& vertexArray, uint32_t instanceCount, uint32_t indexCount, uint32_t baseInstance)
+	{
+		const auto& indexBuffer = vertexArray.GetIndexBuffer();
+		uint32_t count = indexCount ? indexCount : indexBuffer->GetCount();
+		GLenum type = IndexTypeToOpenGLType(indexBuffer->GetIndexType());
+		if (baseInstance)
+			glDrawElementsInstancedBaseInstance(GL_TRIANGLES, count, type, nullptr, instanceCount, baseInstance);
+		else
+			glDrawElementsInstanced(GL_TRIANGLES, count, type, nullptr, instanceCount);
+	}
+
+	static void DrawArraysIndirectCommands(VertexArray& vertexArray, IndirectBuffer& indirectBuffer, uint32_t offset)
+	{
+		vertexArray.Bind();
+		indirectBuffer.Bind();
+		glDrawArraysIndirect(GL_TRIANGLES, (const void*)(uintptr_t)offset);
+	}
+
+	static void MultiDrawElementsIndirectCommands(VertexArray& vertexArray, IndirectBuffer& indirectBuffer, uint32_t drawCount, uint32_t offset)
+	{
+		vertexArray.Bind();
+		indirectBuffer.Bind();
+		glMultiDrawElementsIndirect(GL_TRIANGLES, IndexTypeToOpenGLType(vertexArray.GetIndexBuffer()->GetIndexType()), (const void*)(uintptr_t)offset, drawCount, 0);
+	}
+
+	void OpenGLRendererAPI::DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray, uint32_t indexCount, uint32_t baseVertex)
+	{
+		DrawElements(*vertexArray, indexCount, baseVertex);
+	}
+
+	void OpenGLRendererAPI::DrawIndexedInstanced(const std::shared_ptr<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount, uint32_t baseInstance)
+	{
+		DrawElementsInstanced(*vertexArray, instanceCount, indexCount, baseInstance);
+	}
+
+	void OpenGLRendererAPI::DrawArraysIndirect(const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<IndirectBuffer>& indirectBuffer, uint32_t offset)
+	{
+		DrawArraysIndirectCommands(*vertexArray, *indirectBuffer, offset);
+	}
+
+	void OpenGLRendererAPI::MultiDrawIndexedIndirect(const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<IndirectBuffer>& indirectBuffer, uint32_t drawCount, uint32_t offset)
+	{
+		MultiDrawElementsIndirectCommands(*vertexArray, *indirectBuffer, drawCount, offset);
+	}
+
+	void OpenGLRendererAPI::DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+	{
+		glDispatchCompute(groupsX, groupsY, groupsZ);
+	}
+
+	void OpenGLRendererAPI::InsertMemoryBarrier(uint32_t barriers)
+	{
+		GLbitfield bits = 0;
+		if (barriers == MemoryBarrier_All)
+			bits = GL_ALL_BARRIER_BITS;
+		else
+		{
+			if (barriers & MemoryBarrier_ShaderStorage)
+				bits |= GL_SHADER_STORAGE_BARRIER_BIT;
+			if (barriers & MemoryBarrier_Command)
+				bits |= GL_COMMAND_BARRIER_BIT;
+			if (barriers & MemoryBarrier_VertexAttribute)
+				bits |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+			if (barriers & MemoryBarrier_BufferUpdate)
+				bits |= GL_BUFFER_UPDATE_BARRIER_BIT;
+		}
+		glMemoryBarrier(bits);
+	}
+
+	RendererAPI::StateCacheStatistics OpenGLRendererAPI::GetStateCacheStats() const
+	{
+		OpenGLStateCache::Statistics cacheStats = OpenGLStateCache::GetStats();
+		StateCacheStatistics stats;
+		stats.Hits = cacheStats.Hits;
+		stats.Misses = cacheStats.Misses;
+		return stats;
+	}
+
+	void OpenGLRendererAPI::ResetStateCacheStats()
+	{
+		OpenGLStateCache::ResetStats();
+	}
+
+	void OpenGLRendererAPI::Execute(const RenderCommandQueue& queue)
 	{
-		glDrawElements(GL_TRIANGLES, vertexArray->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
+		// Member calls are qualified so the replay does not go through the vtable per command
+		const uint8_t* record = queue.GetData();
+		const uint8_t* end = record + queue.GetSize();
+		while (record < end)
+		{
+			const RenderCommandHeader* header = (const RenderCommandHeader*)record;
+			const void* payload = record + sizeof(RenderCommandHeader);
+			switch (header->Type)
+			{
+			case RenderCommandType::SetViewport:
+			{
+				const auto* command = (const RenderCommands::SetViewport*)payload;
+				OpenGLRendererAPI::SetViewport(command->X, command->Y, command->Width, command->Height);
+				break;
+			}
+			case RenderCommandType::SetClearColor:
+				OpenGLRendererAPI::SetClearColor(((const RenderCommands::SetClearColor*)payload)->Color);
+				break;
+			case RenderCommandType::Clear:
+				OpenGLRendererAPI::Clear();
+				break;
+			case RenderCommandType::SetBlendMode:
+				OpenGLRendererAPI::SetBlendMode(((const RenderCommands::SetBlendMode*)payload)->Mode);
+				break;
+			case RenderCommandType::SetDepthTest:
+				OpenGLRendererAPI::SetDepthTest(((const RenderCommands::SetEnabled*)payload)->Enabled);
+				break;
+			case RenderCommandType::SetDepthWrite:
+				OpenGLRendererAPI::SetDepthWrite(((const RenderCommands::SetEnabled*)payload)->Enabled);
+				break;
+			// The recording thread cannot bind anything, so recorded draws bind their vertex array themselves
+			case RenderCommandType::DrawIndexed:
+			{
+				const auto* command = (const RenderCommands::DrawIndexed*)payload;
+				command->Geometry->Bind();
+				DrawElements(*command->Geometry, command->IndexCount, command->BaseVertex);
+				break;
+			}
+			case RenderCommandType::DrawIndexedInstanced:
+			{
+				const auto* command = (const RenderCommands::DrawIndexedInstanced*)payload;
+				command->Geometry->Bind();
+				DrawElementsInstanced(*command->Geometry, command->InstanceCount, command->IndexCount, command->BaseInstance);
+				break;
+			}
+			case RenderCommandType::DrawArraysIndirect:
+			{
+				const auto* command = (const RenderCommands::DrawIndirect*)payload;
+				DrawArraysIndirectCommands(*command->Geometry, *command->Commands, command->Offset);
+				break;
+			}
+			case RenderCommandType::MultiDrawIndexedIndirect:
+			{
+				const auto* command = (const RenderCommands::DrawIndirect*)payload;
+				MultiDrawElementsIndirectCommands(*command->Geometry, *command->Commands, command->DrawCount, command->Offset);
+				break;
+			}
+			case RenderCommandType::DispatchCompute:
+			{
+				const auto* command = (const RenderCommands::DispatchCompute*)payload;
+				OpenGLRendererAPI::DispatchCompute(command->GroupsX, command->GroupsY, command->GroupsZ);
+				break;
+			}
+			case RenderCommandType::InsertMemoryBarrier:
+				OpenGLRendererAPI::InsertMemoryBarrier(((const RenderCommands::InsertMemoryBarrier*)payload)->Barriers);
+				break;
+			case RenderCommandType::Callback:
+			{
+				void (*invoke)(const void*);
+				memcpy(&invoke, payload, sizeof(invoke));
+				invoke(payload);
+				break;
+			}
+			default:
+				EG_CORE_ASSERT(false, "Unknown render command!");
+				break;
+			}
+			record += header->Size;
+		}
 	}
-}
\ No newline at end of file
+}
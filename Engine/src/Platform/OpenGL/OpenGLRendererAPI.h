@@ -11,6 +11,26 @@ namespace Engine
 		virtual void SetClearColor(const glm::vec4& color) override;
 		virtual void Clear() override;
 
-		virtual void DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray) override;
+		virtual void SetBlendMode(BlendMode mode) override;
+		virtual void SetDepthTest(bool enabled) override;
+		virtual void SetDepthWrite(bool enabled) override;
+
+		virtual void DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t baseVertex = 0) override;
+		virtual void DrawIndexedInstanced(const std::shared_ptr<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount = 0, uint32_t baseInstance = 0) override;
+
+		virtual void DrawArraysIndirect(const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<IndirectBuffer>& indirectBuffer, uint32_t offset = 0) override;
+		virtual void MultiDrawIndexedIndirect(const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<IndirectBuffer>& indirectBuffer, uint32_t drawCount, uint32_t offset = 0) override;
+
+		virtual void DispatchCompute(uint32_t groupsX, uint32_t groupsY = 1, uint32_t groupsZ = 1) override;
+		virtual void InsertMemoryBarrier(uint32_t barriers) override;
+
+		virtual uint32_t GetMaxTextureSlots() const override { return m_MaxTextureSlots; }
+
+		virtual StateCacheStatistics GetStateCacheStats() const override;
+		virtual void ResetStateCacheStats() override;
+
+		virtual void Execute(const RenderCommandQueue& queue) override;
+	private:
+		uint32_t m_MaxTextureSlots = 1;
 	};
 }
@@ -1,16 +1,53 @@
 #include "engine_pch.h"
 #include "OpenGLShader.h"
 
+#include "OpenGLShaderCache.h"
+#include "OpenGLStateCache.h"
+#include "Engine/Renderer/HotReload.h"
 #include <glad/glad.h>
+#include <chrono>
 #include <fstream>
 #include <glm/gtc/type_ptr.hpp>
 
+#ifndef GL_COMPLETION_STATUS_KHR
+	#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace Engine
 {
 	using std::endl;
 	using std::ifstream;
 	using std::stringstream;
 
+	static bool HasParallelShaderCompile()
+	{
+		// GL_KHR_parallel_shader_compile is not part of the generated loader, it only adds a query
+		static int supported = -1;
+		if (supported < 0)
+		{
+			supported = 0;
+			GLint extensionCount = 0;
+			glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+			for (GLint i = 0; i < extensionCount; i++)
+			{
+				const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+				if (!strcmp(extension, "GL_KHR_parallel_shader_compile") || !strcmp(extension, "GL_ARB_parallel_shader_compile"))
+					supported = 1;
+			}
+		}
+		return supported == 1;
+	}
+
+	static std::string ShaderNameFromPath(const char* filePath)
+	{
+		std::string str_path = std::string(filePath);
+		auto lastSlash = str_path.find_last_of("/\\");
+		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
+		auto lastDot = str_path.rfind('.');
+		auto count = lastDot == std::string::npos ? str_path.size() - lastSlash : lastDot - lastSlash;
+		return str_path.substr(lastSlash, count);
+	}
+
 	static GLenum ShaderTypeFromString(const std::string& type)
 	{
 		if (type == "vertex")
@@ -19,6 +56,8 @@ namespace Engine
 			return GL_FRAGMENT_SHADER;
 		else if (type == "geometry")
 			return GL_GEOMETRY_SHADER;
+		else if (type == "compute")
+			return GL_COMPUTE_SHADER;
 		else
 			EG_CORE_ASSERT(false, "Unknown shader type");
 		return 0;
@@ -64,21 +103,13 @@ namespace Engine
 		return loadShader(code, type, fileName);
 	}
 
-	void OpenGLShader::loadShader(const char* fileName)
+	std::unordered_map<GLenum, std::string> OpenGLShader::readSources(const char* fileName, const ShaderDefines& defines)
 	{
-		string codeString;
-		ifstream file(fileName, std::ios::in, std::ios::binary);
-		if (file)
-		{
-			file.seekg(0, std::ios::end);
-			codeString.resize(file.tellg());
-			file.seekg(0, std::ios::beg);
-			file.read(&codeString[0], codeString.size());
-			file.close();
-		}
-		else
-			EG_CORE_ERROR("Unable to open shader file! {0}", fileName);
-		
+		std::vector<std::string> includes;
+		string codeString = ShaderPreprocessor::ReadFile(fileName, &includes);
+		// Reads run for loads and reloads alike, so includes added by an edit are watched as well
+		HotReload::RegisterIncludes(fileName, includes);
+
 		std::unordered_map<GLenum, std::string> shaderMap;
 
 		const char* typeToken = "#type";
@@ -95,38 +126,210 @@ namespace Engine
 
 			size_t nextLinePos = codeString.find_first_not_of("\r\n", eol);
 			pos = codeString.find(typeToken, nextLinePos);
-			shaderMap[ShaderTypeFromString(type)] = codeString.substr(nextLinePos, pos - (nextLinePos == std::string::npos ? codeString.size() - 1 : nextLinePos));
+			shaderMap[ShaderTypeFromString(type)] = ShaderPreprocessor::InjectDefines(codeString.substr(nextLinePos, pos - (nextLinePos == std::string::npos ? codeString.size() - 1 : nextLinePos)), defines);
 		}
 
-		loadProgram(shaderMap, fileName);
+		return shaderMap;
 	}
 
-	void OpenGLShader::loadProgram(const std::unordered_map<GLenum, std::string>& shaderMap, const char* fileName)
+	void OpenGLShader::beginBuild(ProgramBuild& build, const std::unordered_map<GLenum, std::string>& sources) const
 	{
-		id = glCreateProgram();
+		build.Program = glCreateProgram();
+
+		build.CacheKey = OpenGLShaderCache::ComputeKey(sources);
+		build.FromCache = OpenGLShaderCache::Load(build.Program, build.CacheKey, m_FilePath.c_str());
+		if (build.FromCache)
+			return;
 
-		std::vector<unsigned int> shaderIDs;
-		shaderIDs.resize(shaderMap.size());
-		unsigned int i = 0;
-		for (auto& kv : shaderMap)
+		auto start = std::chrono::steady_clock::now();
+		for (auto& kv : sources)
 		{
-			shaderIDs[i] = loadShader(kv.second.c_str(), kv.first, fileName);
-			glAttachShader(id, shaderIDs[i]);
-			i++;
+			unsigned int stageId = glCreateShader(kv.first);
+			const char* code = kv.second.c_str();
+			glShaderSource(stageId, 1, &code, NULL);
+			glCompileShader(stageId);
+			glAttachShader(build.Program, stageId);
+			build.StageIDs.push_back(stageId);
 		}
-		glLinkProgram(id);
+		OpenGLShaderCache::PrepareProgram(build.Program);
+		// No status is queried before endBuild, so the driver is free to compile in the background
+		glLinkProgram(build.Program);
+		build.DriverMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	bool OpenGLShader::isBuildComplete(const ProgramBuild& build)
+	{
+		// Without the extension there is no way to ask without waiting, a linking program counts as complete
+		if (build.FromCache || !HasParallelShaderCompile())
+			return true;
+
+		int completed;
+		glGetProgramiv(build.Program, GL_COMPLETION_STATUS_KHR, &completed);
+		return completed;
+	}
 
+	bool OpenGLShader::endBuild(ProgramBuild& build) const
+	{
+		if (build.FromCache)
+			return true;
+
+		// Blocks until the driver is done with whatever it has not finished in the background
 		int success;
 		char infoLog[512];
-		glGetProgramiv(id, GL_COMPILE_STATUS, &success);
+		auto start = std::chrono::steady_clock::now();
+		glGetProgramiv(build.Program, GL_LINK_STATUS, &success);
+		build.DriverMilliseconds += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
 		if (!success)
 		{
-			glGetProgramInfoLog(id, 512, NULL, infoLog);
+			for (unsigned int stageId : build.StageIDs)
+			{
+				int compiled;
+				glGetShaderiv(stageId, GL_COMPILE_STATUS, &compiled);
+				if (!compiled)
+				{
+					glGetShaderInfoLog(stageId, 512, NULL, infoLog);
+					EG_CORE_ERROR("Shader compilation failure! \n({0}) {1}", m_FilePath, infoLog);
+				}
+			}
+			glGetProgramInfoLog(build.Program, 512, NULL, infoLog);
 			EG_CORE_ERROR("Program compilation failure! \n{0}", infoLog);
 		}
 
-		for (size_t i = 0; i < shaderIDs.size(); i++)
-			glDeleteShader(shaderIDs[i]);
+		for (unsigned int stageId : build.StageIDs)
+			glDeleteShader(stageId);
+		build.StageIDs.clear();
+
+		if (success)
+		{
+			OpenGLShaderCache::Save(build.Program, build.CacheKey, m_FilePath.c_str(), build.DriverMilliseconds);
+		}
+		return success;
+	}
+
+	void OpenGLShader::discardBuild(ProgramBuild& build)
+	{
+		for (unsigned int stageId : build.StageIDs)
+			glDeleteShader(stageId);
+		build.StageIDs.clear();
+		glDeleteProgram(build.Program);
+		build.Program = 0;
+	}
+
+	void OpenGLShader::submitProgram()
+	{
+		beginBuild(m_Build, m_Sources);
+		id = m_Build.Program;
+		m_Sources.clear();
+		m_LoadState = LoadState::Linking;
+	}
+
+	void OpenGLShader::finishProgram()
+	{
+		endBuild(m_Build);
+		m_Build.Program = 0;
+
+		// Set first, the reflection below goes through methods that finish pending loads
+		m_LoadState = LoadState::Ready;
+		reflect();
+	}
+
+	void OpenGLShader::ensureReady() const
+	{
+		if (m_LoadState == LoadState::Ready)
+			return;
+
+		// Finishing a deferred load only changes when the work happens, not what the shader is
+		OpenGLShader* self = const_cast<OpenGLShader*>(this);
+		self->Submit();
+		if (m_LoadState == LoadState::Linking)
+			self->finishProgram();
+	}
+
+	void OpenGLShader::LoadSources()
+	{
+		if (m_LoadState != LoadState::Queued)
+			return;
+
+		m_Sources = readSources(m_FilePath.c_str(), m_Defines);
+		m_LoadState = LoadState::Sourced;
+	}
+
+	void OpenGLShader::Submit()
+	{
+		RenderCommand::RequireContext("Shader::Submit");
+		LoadSources();
+		if (m_LoadState == LoadState::Sourced)
+			submitProgram();
+	}
+
+	bool OpenGLShader::IsReady() const
+	{
+		switch (m_LoadState)
+		{
+		case LoadState::Queued:
+		case LoadState::Sourced:
+			return false;
+		case LoadState::Linking:
+			return isBuildComplete(m_Build);
+		}
+		return true;
+	}
+
+	void OpenGLShader::Reload()
+	{
+		if (m_FilePath.empty() || m_LoadState != LoadState::Ready)
+			return;
+
+		// A read still in flight restarts once it returns, waiting for it here would stall the frame
+		if (m_ReloadSources.valid())
+		{
+			m_ReloadAgain = true;
+			return;
+		}
+
+		if (m_ReloadBuild.Program)
+			discardBuild(m_ReloadBuild);
+		std::string filePath = m_FilePath;
+		ShaderDefines defines = m_Defines;
+		m_ReloadSources = std::async(std::launch::async, [filePath, defines]() { return readSources(filePath.c_str(), defines); });
+	}
+
+	bool OpenGLShader::UpdateReload()
+	{
+		if (m_ReloadSources.valid())
+		{
+			if (m_ReloadSources.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+				return false;
+
+			std::unordered_map<GLenum, std::string> sources = m_ReloadSources.get();
+			if (m_ReloadAgain)
+			{
+				m_ReloadAgain = false;
+				Reload();
+				return false;
+			}
+			beginBuild(m_ReloadBuild, sources);
+		}
+
+		if (!m_ReloadBuild.Program)
+			return true;
+		if (!isBuildComplete(m_ReloadBuild))
+			return false;
+
+		if (!endBuild(m_ReloadBuild))
+		{
+			EG_CORE_WARN("Keeping the previous program of {0}", m_FilePath);
+			discardBuild(m_ReloadBuild);
+			return true;
+		}
+
+		OpenGLStateCache::OnProgramDeleted(id);
+		glDeleteProgram(id);
+		id = m_ReloadBuild.Program;
+		m_ReloadBuild.Program = 0;
+		reflect();
+		EG_CORE_INFO("Reloaded shader {0}", m_FilePath);
+		return true;
 	}
 
 	void OpenGLShader::loadProgram(unsigned int vertexId, unsigned int fragmentId, unsigned int geometryId)
@@ -139,7 +342,7 @@ namespace Engine
 
 		int success;
 		char infoLog[512];
-		glGetProgramiv(id, GL_COMPILE_STATUS, &success);
+		glGetProgramiv(id, GL_LINK_STATUS, &success);
 		if (!success)
 		{
 			glGetProgramInfoLog(id, 512, NULL, infoLog);
@@ -149,6 +352,8 @@ namespace Engine
 		glDeleteShader(vertexId);
 		glDeleteShader(fragmentId);
 		if (geometryId) { glDeleteShader(geometryId); }
+
+		reflect();
 	}
 
 	OpenGLShader::OpenGLShader()
@@ -157,32 +362,31 @@ namespace Engine
 	}
 
 	OpenGLShader::OpenGLShader(const OpenGLShader& shader)
-		: id(shader.id), texSlotCounter(shader.texSlotCounter)
+		: id(shader.id), texSlotCounter(shader.texSlotCounter), m_Reflection(shader.m_Reflection), m_UniformIndices(shader.m_UniformIndices),
+		m_UniformSlots(shader.m_UniformSlots), m_UniformShadow(shader.m_UniformShadow)
 	{}
 
 	OpenGLShader::OpenGLShader(const char* shaderFile)
+		: id(0), texSlotCounter(0), name(ShaderNameFromPath(shaderFile)), m_FilePath(shaderFile)
 	{
-		loadShader(shaderFile);
+		m_LoadState = LoadState::Queued;
+		ensureReady();
+	}
 
-		std::string str_path = std::string(shaderFile);
-		auto lastSlash = str_path.find_last_of("/\\");
-		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
-		auto lastDot = str_path.rfind('.');
-		auto count = lastDot == std::string::npos ? str_path.size() - lastSlash : lastDot - lastSlash;
-		name = str_path.substr(lastSlash, count);
+	OpenGLShader::OpenGLShader(const char* shaderFile, DeferredLoad, const ShaderDefines& defines)
+		: id(0), texSlotCounter(0), name(ShaderNameFromPath(shaderFile)), m_FilePath(shaderFile), m_Defines(defines)
+	{
+		// Permutations of one file get distinct names, so that they can share a ShaderLibrary
+		if (!defines.empty())
+			name += "[" + ShaderPreprocessor::VariantKey(defines) + "]";
+		m_LoadState = LoadState::Queued;
 	}
 
 	OpenGLShader::OpenGLShader(const char* vertexShaderFile, const char* fragmentShaderFile, const char* geometryShaderFile)
 		: id(0), texSlotCounter(0)
 	{
 		compile(vertexShaderFile, fragmentShaderFile, geometryShaderFile);
-
-		std::string str_path = std::string(vertexShaderFile);
-		auto lastSlash = str_path.find_last_of("/\\");
-		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
-		auto lastDot = str_path.rfind('.');
-		auto count = lastDot == std::string::npos ? str_path.size() - lastSlash : lastDot - lastSlash;
-		name = str_path.substr(lastSlash, count);
+		name = ShaderNameFromPath(vertexShaderFile);
 	}
 
 	OpenGLShader::OpenGLShader(int dummy, const char* shaderName, const char* vertexShaderCode, const char* fragmentShaderCode, const char* geometricShaderCode)
@@ -241,10 +445,18 @@ namespace Engine
 		glDeleteShader(sFragment);
 		if (geometrySource != nullptr)
 			glDeleteShader(gShader);
+
+		reflect();
 	}
 
 	OpenGLShader::~OpenGLShader()
 	{
+		// Outstanding file reads are waited for by their futures
+		if (m_Build.Program)
+			discardBuild(m_Build);
+		if (m_ReloadBuild.Program)
+			discardBuild(m_ReloadBuild);
+		OpenGLStateCache::OnProgramDeleted(id);
 		glDeleteProgram(id);
 	}
 
@@ -272,440 +484,731 @@ namespace Engine
 		}
 	}
 
+	void OpenGLShader::Bind() const
+	{
+		ensureReady();
+		OpenGLStateCache::UseProgram(id);
+	}
+
+	void OpenGLShader::Unbind() const
+	{
+		OpenGLStateCache::UseProgram(0);
+	}
+
 	OpenGLShader& OpenGLShader::use()
 	{
-		glUseProgram(id);
+		ensureReady();
+		OpenGLStateCache::UseProgram(id);
 		return *this;
 	}
 
+	static UniformType UniformTypeFromGL(GLenum type)
+	{
+		switch (type)
+		{
+		case GL_INT:
+		case GL_BOOL:
+		case GL_SAMPLER_1D:
+		case GL_SAMPLER_2D:
+		case GL_SAMPLER_3D:
+		case GL_SAMPLER_CUBE:
+		case GL_SAMPLER_1D_ARRAY:
+		case GL_SAMPLER_2D_ARRAY:
+		case GL_SAMPLER_2D_SHADOW:
+		case GL_SAMPLER_2D_ARRAY_SHADOW:
+		case GL_SAMPLER_CUBE_SHADOW:
+		case GL_SAMPLER_2D_MULTISAMPLE:
+		case GL_SAMPLER_BUFFER:
+		case GL_INT_SAMPLER_2D:
+		case GL_UNSIGNED_INT_SAMPLER_2D:
+		case GL_IMAGE_2D:
+			return UniformType::Int;
+		case GL_UNSIGNED_INT:		return UniformType::UInt;
+		case GL_FLOAT:				return UniformType::Float;
+		case GL_FLOAT_VEC2:			return UniformType::Float2;
+		case GL_FLOAT_VEC3:			return UniformType::Float3;
+		case GL_FLOAT_VEC4:			return UniformType::Float4;
+		case GL_FLOAT_MAT3:			return UniformType::Mat3;
+		case GL_FLOAT_MAT4:			return UniformType::Mat4;
+		}
+		return UniformType::None;
+	}
+
+	// Component layout of a vertex input type
+	static void AttributeShapeFromGL(GLenum type, ShaderAttributeInfo& attribute)
+	{
+		switch (type)
+		{
+		case GL_FLOAT:				attribute.ComponentCount = 1; return;
+		case GL_FLOAT_VEC2:			attribute.ComponentCount = 2; return;
+		case GL_FLOAT_VEC3:			attribute.ComponentCount = 3; return;
+		case GL_FLOAT_VEC4:			attribute.ComponentCount = 4; return;
+		case GL_FLOAT_MAT2:			attribute.ComponentCount = 2; attribute.LocationCount = 2; return;
+		case GL_FLOAT_MAT3:			attribute.ComponentCount = 3; attribute.LocationCount = 3; return;
+		case GL_FLOAT_MAT4:			attribute.ComponentCount = 4; attribute.LocationCount = 4; return;
+		case GL_INT:
+		case GL_UNSIGNED_INT:		attribute.ComponentCount = 1; attribute.Integer = true; return;
+		case GL_INT_VEC2:
+		case GL_UNSIGNED_INT_VEC2:	attribute.ComponentCount = 2; attribute.Integer = true; return;
+		case GL_INT_VEC3:
+		case GL_UNSIGNED_INT_VEC3:	attribute.ComponentCount = 3; attribute.Integer = true; return;
+		case GL_INT_VEC4:
+		case GL_UNSIGNED_INT_VEC4:	attribute.ComponentCount = 4; attribute.Integer = true; return;
+		}
+		attribute.ComponentCount = 4;
+	}
+
+	static std::string ProgramResourceName(GLuint program, GLenum programInterface, GLuint index, std::vector<char>& buffer)
+	{
+		GLsizei length = 0;
+		glGetProgramResourceName(program, programInterface, index, (GLsizei)buffer.size(), &length, buffer.data());
+		return std::string(buffer.data(), length);
+	}
+
+	static std::vector<char> ProgramResourceNameBuffer(GLuint program, GLenum programInterface)
+	{
+		GLint maxNameLength = 0;
+		glGetProgramInterfaceiv(program, programInterface, GL_MAX_NAME_LENGTH, &maxNameLength);
+		return std::vector<char>(std::max(maxNameLength, 1));
+	}
+
+	static uint64_t s_ReflectionVersion = 0;
+
+	void OpenGLShader::reflect()
+	{
+		reflectUniforms();
+		bindUniformBlocks();
+
+		// Programs only link on the thread owning the context, the counter needs no synchronisation
+		m_Reflection.Version = ++s_ReflectionVersion;
+		reflectAttributes();
+		reflectBlocks(GL_UNIFORM_BLOCK, m_Reflection.UniformBlocks);
+		reflectBlocks(GL_SHADER_STORAGE_BLOCK, m_Reflection.StorageBlocks);
+	}
+
+	void OpenGLShader::reflectAttributes()
+	{
+		m_Reflection.Attributes.clear();
+
+		GLint inputCount = 0;
+		glGetProgramInterfaceiv(id, GL_PROGRAM_INPUT, GL_ACTIVE_RESOURCES, &inputCount);
+		std::vector<char> nameBuffer = ProgramResourceNameBuffer(id, GL_PROGRAM_INPUT);
+
+		const GLenum properties[] = { GL_TYPE, GL_LOCATION, GL_ARRAY_SIZE };
+		for (GLint i = 0; i < inputCount; i++)
+		{
+			GLint values[3] = {};
+			glGetProgramResourceiv(id, GL_PROGRAM_INPUT, (GLuint)i, 3, properties, 3, nullptr, values);
+			// Built-in inputs such as gl_VertexID have no location
+			if (values[1] < 0)
+				continue;
+
+			ShaderAttributeInfo attribute;
+			attribute.Name = ProgramResourceName(id, GL_PROGRAM_INPUT, (GLuint)i, nameBuffer);
+			attribute.Location = values[1];
+			AttributeShapeFromGL((GLenum)values[0], attribute);
+			attribute.LocationCount *= (uint32_t)std::max(values[2], 1);
+			m_Reflection.Attributes.push_back(std::move(attribute));
+		}
+
+		std::sort(m_Reflection.Attributes.begin(), m_Reflection.Attributes.end(),
+			[](const ShaderAttributeInfo& a, const ShaderAttributeInfo& b) { return a.Location < b.Location; });
+	}
+
+	void OpenGLShader::reflectBlocks(GLenum programInterface, std::vector<ShaderBlockInfo>& blocks)
+	{
+		blocks.clear();
+
+		GLint blockCount = 0;
+		glGetProgramInterfaceiv(id, programInterface, GL_ACTIVE_RESOURCES, &blockCount);
+		std::vector<char> nameBuffer = ProgramResourceNameBuffer(id, programInterface);
+
+		const GLenum properties[] = { GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE };
+		for (GLint i = 0; i < blockCount; i++)
+		{
+			GLint values[2] = {};
+			glGetProgramResourceiv(id, programInterface, (GLuint)i, 2, properties, 2, nullptr, values);
+
+			ShaderBlockInfo block;
+			block.Name = ProgramResourceName(id, programInterface, (GLuint)i, nameBuffer);
+			block.Binding = (uint32_t)values[0];
+			block.Size = (uint32_t)values[1];
+			blocks.push_back(std::move(block));
+		}
+	}
+
+	void OpenGLShader::reflectUniforms()
+	{
+		// After a reload, uniforms that are still there keep their index, so UniformHandles stay valid, and their value.
+		// Indices of uniforms that are gone stay reserved by an entry of type None, which ignores every upload.
+		std::vector<UniformInfo> previous = std::move(m_Reflection.Uniforms);
+		std::vector<uint8_t> previousShadow = std::move(m_UniformShadow);
+		std::unordered_map<StringId, int> previousIndices = std::move(m_UniformIndices);
+		m_Reflection.Uniforms.assign(previous.size(), UniformInfo());
+		m_UniformIndices.clear();
+		m_UniformSlots.clear();
+
+		GLint uniformCount = 0, maxNameLength = 0;
+		glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &uniformCount);
+		glGetProgramiv(id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+		std::vector<char> nameBuffer(std::max(maxNameLength, 1));
+
+		for (GLint i = 0; i < uniformCount; i++)
+		{
+			GLint size = 0;
+			GLenum type = 0;
+			GLsizei nameLength = 0;
+			glGetActiveUniform(id, (GLuint)i, (GLsizei)nameBuffer.size(), &nameLength, &size, &type, nameBuffer.data());
+
+			// Members of uniform blocks have no location
+			UniformInfo uniform;
+			uniform.Location = glGetUniformLocation(id, nameBuffer.data());
+			if (uniform.Location < 0)
+				continue;
+
+			uniform.Name.assign(nameBuffer.data(), nameLength);
+			if (uniform.Name.size() > 3 && uniform.Name.compare(uniform.Name.size() - 3, 3, "[0]") == 0)
+				uniform.Name.resize(uniform.Name.size() - 3);
+			uniform.Type = UniformTypeFromGL(type);
+			uniform.Count = (uint32_t)size;
+
+			StringId nameId(uniform.Name);
+			auto it = previousIndices.find(nameId);
+			int index = it != previousIndices.end() && previous[it->second].Type == uniform.Type ? it->second : (int)m_Reflection.Uniforms.size();
+			if (index == (int)m_Reflection.Uniforms.size())
+				m_Reflection.Uniforms.emplace_back();
+
+			// Array elements occupy consecutive locations
+			if (m_UniformSlots.size() < uniform.Location + uniform.Count)
+				m_UniformSlots.resize(uniform.Location + uniform.Count);
+			for (uint32_t element = 0; element < uniform.Count; element++)
+				m_UniformSlots[uniform.Location + element] = { index, element };
+
+			m_UniformIndices[nameId] = index;
+			m_Reflection.Uniforms[index] = std::move(uniform);
+		}
+
+		uint32_t shadowSize = 0;
+		for (UniformInfo& uniform : m_Reflection.Uniforms)
+		{
+			uniform.Offset = shadowSize;
+			shadowSize += UniformTypeSize(uniform.Type) * uniform.Count;
+		}
+		m_UniformShadow.assign(shadowSize, 0);
+
+		// Initializers and layout(binding) give uniforms values other than zero, uploads are compared against what the program holds
+		for (const UniformInfo& uniform : m_Reflection.Uniforms)
+		{
+			uint32_t elementSize = UniformTypeSize(uniform.Type);
+			for (uint32_t element = 0; element < uniform.Count; element++)
+			{
+				void* shadow = m_UniformShadow.data() + uniform.Offset + element * elementSize;
+				int location = uniform.Location + (int)element;
+				switch (uniform.Type)
+				{
+				case UniformType::None:		break;
+				case UniformType::Int:		glGetUniformiv(id, location, (GLint*)shadow); break;
+				case UniformType::UInt:		glGetUniformuiv(id, location, (GLuint*)shadow); break;
+				default:					glGetUniformfv(id, location, (GLfloat*)shadow); break;
+				}
+			}
+		}
+
+		for (size_t i = 0; i < previous.size(); i++)
+		{
+			if (m_Reflection.Uniforms[i].Type != UniformType::None && m_Reflection.Uniforms[i].Type == previous[i].Type)
+				SetUniform((int)i, previousShadow.data() + previous[i].Offset, std::min(previous[i].Count, m_Reflection.Uniforms[i].Count));
+		}
+	}
+
+	void OpenGLShader::bindUniformBlocks()
+	{
+		GLuint sceneDataIndex = getUniformBlockIndex(SceneDataBlockName);
+		if (sceneDataIndex != GL_INVALID_INDEX)
+			uniformBlockBinding(sceneDataIndex, SceneDataBinding);
+	}
+
+	int OpenGLShader::FindUniform(StringId name) const
+	{
+		ensureReady();
+		auto it = m_UniformIndices.find(name);
+		return it != m_UniformIndices.end() ? it->second : -1;
+	}
+
+	const ShaderReflection& OpenGLShader::GetReflection() const
+	{
+		ensureReady();
+		return m_Reflection;
+	}
+
+	const UniformInfo& OpenGLShader::GetUniformInfo(int index) const
+	{
+		ensureReady();
+		return m_Reflection.Uniforms[index];
+	}
+
+	void OpenGLShader::SetUniform(int index, const void* data, uint32_t count, uint32_t firstElement) const
+	{
+		ensureReady();
+		EG_CORE_ASSERT(index >= 0 && index < (int)m_Reflection.Uniforms.size(), "Invalid uniform index!");
+		const UniformInfo& uniform = m_Reflection.Uniforms[index];
+		if (firstElement >= uniform.Count)
+			return;
+		count = std::min(count, uniform.Count - firstElement);
+
+		uint32_t elementSize = UniformTypeSize(uniform.Type);
+		uint8_t* shadow = m_UniformShadow.data() + uniform.Offset + firstElement * elementSize;
+		if (memcmp(shadow, data, (size_t)elementSize * count) == 0)
+			return;
+		memcpy(shadow, data, (size_t)elementSize * count);
+
+		int location = uniform.Location + (int)firstElement;
+		switch (uniform.Type)
+		{
+		case UniformType::Int:		glProgramUniform1iv(id, location, count, (const GLint*)data); break;
+		case UniformType::UInt:		glProgramUniform1uiv(id, location, count, (const GLuint*)data); break;
+		case UniformType::Float:	glProgramUniform1fv(id, location, count, (const GLfloat*)data); break;
+		case UniformType::Float2:	glProgramUniform2fv(id, location, count, (const GLfloat*)data); break;
+		case UniformType::Float3:	glProgramUniform3fv(id, location, count, (const GLfloat*)data); break;
+		case UniformType::Float4:	glProgramUniform4fv(id, location, count, (const GLfloat*)data); break;
+		case UniformType::Mat3:		glProgramUniformMatrix3fv(id, location, count, GL_FALSE, (const GLfloat*)data); break;
+		case UniformType::Mat4:		glProgramUniformMatrix4fv(id, location, count, GL_FALSE, (const GLfloat*)data); break;
+		}
+	}
+
+	// Hashes without recording the text, which is only needed for table keys; the string setters run per frame
+	static StringId LookupId(const string& name)
+	{
+		return StringId::FromHash(StringId::Hash(name.data(), name.size()));
+	}
+
+	// The string and location setters bind the program as they always have, then go through the uniform table
+	void OpenGLShader::setUniform(const string& name, UniformType type, const void* data, uint32_t count) const
+	{
+		ensureReady();
+		OpenGLStateCache::UseProgram(id);
+		int index = FindUniform(LookupId(name));
+		if (index >= 0 && m_Reflection.Uniforms[index].Type == type)
+			SetUniform(index, data, count);
+	}
+
+	void OpenGLShader::setUniform(int location, UniformType type, const void* data, uint32_t count) const
+	{
+		ensureReady();
+		OpenGLStateCache::UseProgram(id);
+		if (location < 0 || location >= (int)m_UniformSlots.size())
+			return;
+		const UniformSlot& slot = m_UniformSlots[location];
+		if (slot.Uniform >= 0 && m_Reflection.Uniforms[slot.Uniform].Type == type)
+			SetUniform(slot.Uniform, data, count, slot.Element);
+	}
+
 	int OpenGLShader::getUniformLocation(const string& name) const
 	{
-		return glGetUniformLocation(id, name.c_str());
+		ensureReady();
+		int index = FindUniform(LookupId(name));
+		return index >= 0 ? m_Reflection.Uniforms[index].Location : -1;
 	}
 
 	GLuint OpenGLShader::getUniformBlockIndex(const string& name) const
 	{
+		ensureReady();
 		return glGetUniformBlockIndex(id, name.c_str());
 	}
 
 	GLuint OpenGLShader::getUniformBlockIndex(const string& listName, const string& memberName, const unsigned int& index) const
 	{
+		ensureReady();
 		return glGetUniformBlockIndex(id, (listName + "[" + std::to_string(index) + "]." + memberName).c_str());
 	}
 
 	void OpenGLShader::uniformBlockBinding(GLuint uniformBlockIndex, int bindingPoint)
 	{
+		ensureReady();
 		glUniformBlockBinding(id, uniformBlockIndex, bindingPoint);
 	}
 
 	void OpenGLShader::setBool(const string& name, bool value) const
 	{
-		glUseProgram(id);
-		glUniform1i(glGetUniformLocation(id, name.c_str()), (int)value);
+		int intValue = (int)value;
+		setUniform(name, UniformType::Int, &intValue);
 	}
 
 	void OpenGLShader::setBool(int location, bool value) const
 	{
-		glUseProgram(id);
-		glUniform1i(location, (int)value);
+		int intValue = (int)value;
+		setUniform(location, UniformType::Int, &intValue);
 	}
 
 	void OpenGLShader::setInt(const string& name, int value) const
 	{
-		glUseProgram(id);
-		glUniform1i(glGetUniformLocation(id, name.c_str()), value);
+		setUniform(name, UniformType::Int, &value);
 	}
 
 	void OpenGLShader::setInt(const string& listName, const string& memberName, const int& value) const
 	{
-		glUseProgram(id);
-		glUniform1i(glGetUniformLocation(id, (listName + "." + memberName).c_str()), value);
+		setUniform(listName + "." + memberName, UniformType::Int, &value);
 	}
 
 	void OpenGLShader::setInt(const string& listName, const string& memberName, int value, const unsigned int& idx) const
 	{
-		glUseProgram(id);
-		glUniform1i(getUniformBlockIndex(listName, memberName, idx), value);
+		setUniform(listName + "[" + std::to_string(idx) + "]." + memberName, UniformType::Int, &value);
 	}
 
 	void OpenGLShader::setInt(int location, int value) const
 	{
-		glUseProgram(id);
-		glUniform1i(location, value);
+		setUniform(location, UniformType::Int, &value);
 	}
 
 	void OpenGLShader::setInt_vector(const string& name, const vector<int> vec) const
 	{
-		glUseProgram(id);
-		for (size_t i = 0; i < vec.size(); i++)
-			setInt(getUniformLocation(name + "[" + std::to_string(i) + "]"), vec[i]);
+		setUniform(name, UniformType::Int, vec.data(), (uint32_t)vec.size());
 	}
 
 	void OpenGLShader::setInt_vector(const string& name, const int& value, const unsigned int& size) const
 	{
-		glUseProgram(id);
-		for (size_t i = 0; i < size; i++)
-			setInt(getUniformLocation(name + "[" + std::to_string(i) + "]"), value);
+		vector<int> values(size, value);
+		setUniform(name, UniformType::Int, values.data(), size);
 	}
 
 	void OpenGLShader::setInt_vector(const string& listName, const string& memberName, const vector<int>& vec) const
 	{
-		glUseProgram(id);
 		for (size_t i = 0; i < vec.size(); i++)
-			setInt(getUniformLocation(listName + "[" + std::to_string(i) + "]." + memberName), vec[i]);
+			setUniform(listName + "[" + std::to_string(i) + "]." + memberName, UniformType::Int, &vec[i]);
 	}
 
 	void OpenGLShader::setInt_vector(const string& listName, const string& memberName, const int& value, const unsigned int& size) const
 	{
-		glUseProgram(id);
 		for (size_t i = 0; i < size; i++)
-			setInt(getUniformLocation(listName + "[" + std::to_string(i) + "]." + memberName), value);
+			setUniform(listName + "[" + std::to_string(i) + "]." + memberName, UniformType::Int, &value);
 	}
 
 	void OpenGLShader::setFloat(const string& name, float value) const
 	{
-		glUseProgram(id);
-		glUniform1f(glGetUniformLocation(id, name.c_str()), value);
+		setUniform(name, UniformType::Float, &value);
 	}
 
 	void OpenGLShader::setFloat(const string& listName, const string& memberName, const float& value) const
 	{
-		glUseProgram(id);
-		glUniform1f(glGetUniformLocation(id, (listName + "." + memberName).c_str()), value);
+		setUniform(listName + "." + memberName, UniformType::Float, &value);
 	}
 
 	void OpenGLShader::setFloat(const string& listName, const string& memberName, float value, const unsigned int& idx) const
 	{
-		glUseProgram(id);
-		glUniform1f(getUniformBlockIndex(listName, memberName, idx), value);
+		setUniform(listName + "[" + std::to_string(idx) + "]." + memberName, UniformType::Float, &value);
 	}
 
 	void OpenGLShader::setFloat(int location, float value) const
 	{
-		glUseProgram(id);
-		glUniform1f(location, value);
+		setUniform(location, UniformType::Float, &value);
 	}
 
 	void OpenGLShader::setFloat_vector(const string& name, const vector<float>& vec) const
 	{
-		glUseProgram(id);
-		for (size_t i = 0; i < vec.size(); i++)
-			setFloat(getUniformLocation(name + "[" + std::to_string(i) + "]"), vec[i]);
+		setUniform(name, UniformType::Float, vec.data(), (uint32_t)vec.size());
 	}
 
 	void OpenGLShader::setFloat_vector(const string& name, const float& value, const unsigned int& size) const
 	{
-		glUseProgram(id);
-		for (size_t i = 0; i < size; i++)
-			setFloat(getUniformLocation(name + "[" + std::to_string(i) + "]"), value);
+		vector<float> values(size, value);
+		setUniform(name, UniformType::Float, values.data(), size);
 	}
 
 	void OpenGLShader::setFloat_vector(const string& listName, const string& memberName, const vector<float>& vec) const
 	{
-		glUseProgram(id);
 		for (size_t i = 0; i < vec.size(); i++)
-			setFloat(getUniformLocation(listName + "[" + std::to_string(i) + "]." + memberName), vec[i]);
+			setUniform(listName + "[" + std::to_string(i) + "]." + memberName, UniformType::Float, &vec[i]);
 	}
 
 	void OpenGLShader::setFloat_vector(const string& listName, const string& memberName, const float& value, const unsigned int& size) const
 	{
-		glUseProgram(id);
 		for (size_t i = 0; i < size; i++)
-			setFloat(getUniformLocation(listName + "[" + std::to_string(i) + "]." + memberName), value);
+			setUniform(listName + "[" + std::to_string(i) + "]." + memberName, UniformType::Float, &value);
 	}
 
 	void OpenGLShader::set2fv(const string& name, const glm::vec2& vec) const
 	{
-		glUseProgram(id);
-		glUniform2fv(glGetUniformLocation(id, name.c_str()), 1, glm::value_ptr(vec));
+		setUniform(name, UniformType::Float2, &vec);
 	}
 
 	void OpenGLShader::set2fv(const string& listName, const string& memberName, const glm::vec2& vec) const
 	{
-		glUseProgram(id);
-		glUniform2fv(glGetUniformLocation(id, (listName + "." + memberName).c_str()), 1, glm::value_ptr(vec));
+		setUniform(listName + "." + memberName, UniformType::Float2, &vec);
 	}
 
 	void OpenGLShader::set2fv(const string& listName, const string& memberName, const glm::vec2& vec, const unsigned int& idx) const
 	{
-		glUseProgram(id);
-		glUniform2fv(getUniformBlockIndex(listName, memberName, idx), 1, glm::value_ptr(vec));
+		setUniform(listName + "[" + std::to_string(idx) + "]." + memberName, UniformType::Float2, &vec);
 	}
 
 	void OpenGLShader::set2fv(int location, const glm::vec2& vec) const
 	{
-		glUseProgram(id);
-		glUniform2fv(location, 1, glm::value_ptr(vec));
+		setUniform(location, UniformType::Float2, &vec);
 	}
 
 	void OpenGLShader::set2f(const string& name, float v1, float v2) const
 	{
-		glUseProgram(id);
-		glUniform2f(glGetUniformLocation(id, name.c_str()), v1, v2);
+		glm::vec2 vec(v1, v2);
+		setUniform(name, UniformType::Float2, &vec);
 	}
 
 	void OpenGLShader::set2f(int location, float v1, float v2) const
 	{
-		glUseProgram(id);
-		glUniform2f(location, v1, v2);
+		glm::vec2 vec(v1, v2);
+		setUniform(location, UniformType::Float2, &vec);
 	}
 
 	void OpenGLShader::set2fv_vector(const string& name, const vector<glm::vec2>& vec) const
 	{
-		glUseProgram(id);
-		for (size_t i = 0; i < vec.size(); i++)
-			set2fv(getUniformLocation(name + "[" + std::to_string(i) + "]"), vec[i]);
+		setUniform(name, UniformType::Float2, vec.data(), (uint32_t)vec.size());
 	}
 
 	void OpenGLShader::set2fv_vector(const string& name, const glm::vec2& vec, const unsigned int& size) const
 	{
-		glUseProgram(id);
-		for (size_t i = 0; i < size; i++)
-			set2fv(getUniformLocation(name + "[" + std::to_string(i) + "]"), vec);
+		vector<glm::vec2> values(size, vec);
+		setUniform(name, UniformType::Float2, values.data(), size);
 	}
 
 	void OpenGLShader::set2fv_vector(const string& listName, const string& memberName, const vector<glm::vec2>& vec) const
 	{
-		glUseProgram(id);
 		for (size_t i = 0; i < vec.size(); i++)
-			set2fv(getUniformLocation(listName + "[" + std::to_string(i) + "]." + memberName), vec[i]);
+			setUniform(listName + "[" + std::to_string(i) + "]." + memberName, UniformType::Float2, &vec[i]);
 	}
 
 	void OpenGLShader::set2fv_vector(const string& listName, const string& memberName, const glm::vec2& vec, const unsigned int& size) const
 	{
-		glUseProgram(id);
 		for (size_t i = 0; i < size; i++)
-			set2fv(getUniformLocation(listName + "[" + std::to_string(i) + "]." + memberName), vec);
+			setUniform(listName + "[" + std::to_string(i) + "]." + memberName, UniformType::Float2, &vec);
 	}
 
 	void OpenGLShader::set3fv(const string& name, const glm::vec3& vec) const
 	{
-		glUseProgram(id);
-		glUniform3fv(glGetUniformLocation(id, name.c_str()), 1, glm::value_ptr(vec));
+		setUniform(name, UniformType::Float3, &vec);
 	}
 
 	void OpenGLShader::set3fv(const string& listName, const string& memberName, const glm::vec3& vec) const
 	{
-		glUseProgram(id);
-		glUniform3fv(glGetUniformLocation(id, (listName + "." + memberName).c_str()), 1, glm::value_ptr(vec));
+		setUniform(listName + "." + memberName, UniformType::Float3, &vec);
 	}
 
 	void OpenGLShader::set3fv(const string& listName, const string& memberName, const glm::vec3& vec, const unsigned int& idx) const
 	{
-		glUseProgram(id);
-		glUniform3fv(getUniformBlockIndex(listName, memberName, idx), 1, glm::value_ptr(vec));
+		setUniform(listName + "[" + std::to_string(idx) + "]." + memberName, UniformType::Float3, &vec);
 	}
 
 	void OpenGLShader::set3fv(int location, const glm::vec3& vec) const
 	{
-		glUseProgram(id);
-		glUniform3fv(location, 1, glm::value_ptr(vec));
+		setUniform(location, UniformType::Float3, &vec);
 	}
 
 	void OpenGLShader::set3f(const string& name, float v1, float v2, float v3) const
 	{
-		glUseProgram(id);
-		glUniform3f(glGetUniformLocation(id, name.c_str()), v1, v2, v3);
+		glm::vec3 vec(v1, v2, v3);
+		setUniform(name, UniformType::Float3, &vec);
 	}
 
 	void OpenGLShader::set3f(int location, float v1, float v2, float v3) const
 	{
-		glUseProgram(id);
-		glUniform3f(location, v1, v2, v3);
+		glm::vec3 vec(v1, v2, v3);
+		setUniform(location, UniformType::Float3, &vec);
 	}
 
 	void OpenGLShader::set3fv_vector(const string& name, const vector<glm::vec3>& vec) const
 	{
-		glUseProgram(id);
-		for (size_t i = 0; i < vec.size(); i++)
-			set3fv(getUniformLocation(name + "[" + std::to_string(i) + "]"), vec[i]);
+		setUniform(name, UniformType::Float3, vec.data(), (uint32_t)vec.size());
 	}
 
 	void OpenGLShader::set3fv_vector(const string& name, const glm::vec3& vec, const unsigned int& size) const
 	{
-		glUseProgram(id);
-		for (size_t i = 0; i < size; i++)
-			set3fv(getUniformLocation(name + "[" + std::to_string(i) + "]"), vec);
+		vector<glm::vec3> values(size, vec);
+		setUniform(name, UniformType::Float3, values.data(), size);
 	}
 
 	void OpenGLShader::set3fv_vector(const string& listName, const string& memberName, const vector<glm::vec3>& vec) const
 	{
-		glUseProgram(id);
 		for (size_t i = 0; i < vec.size(); i++)
-			set3fv(getUniformLocation(listName + "[" + std::to_string(i) + "]." + memberName), vec[i]);
+			setUniform(listName + "[" + std::to_string(i) + "]." + memberName, UniformType::Float3, &vec[i]);
 	}
 
 	void OpenGLShader::set3fv_vector(const string& listName, const string& memberName, const glm::vec3& vec, const unsigned int& size) const
 	{
-		glUseProgram(id);
 		for (size_t i = 0; i < size; i++)
-			set3fv(getUniformLocation(listName + "[" + std::to_string(i) + "]." + memberName), vec);
-	}
-
-	void OpenGLShader::set4f(const string& name, float v1, float v2, float v3, float v4) const
-	{
-		glUseProgram(id);
-		glUniform4f(glGetUniformLocation(id, name.c_str()), v1, v2, v3, v4);
+			setUniform(listName + "[" + std::to_string(i) + "]." + memberName, UniformType::Float3, &vec);
 	}
 
 	void OpenGLShader::set4fv(const string& name, const glm::vec4& vec) const
 	{
-		glUseProgram(id);
-		glUniform4fv(glGetUniformLocation(id, name.c_str()), 1, glm::value_ptr(vec));
+		setUniform(name, UniformType::Float4, &vec);
 	}
 
 	void OpenGLShader::set4fv(const string& listName, const string& memberName, const glm::vec4& vec) const
 	{
-		glUseProgram(id);
-		glUniform4fv(glGetUniformLocation(id, (listName + "." + memberName).c_str()), 1, glm::value_ptr(vec));
+		setUniform(listName + "." + memberName, UniformType::Float4, &vec);
 	}
 
 	void OpenGLShader::set4fv(const string& listName, const string& memberName, const glm::vec4& vec, const unsigned int& idx) const
 	{
-		glUseProgram(id);
-		glUniform4fv(getUniformBlockIndex(listName, memberName, idx), 1, glm::value_ptr(vec));
+		setUniform(listName + "[" + std::to_string(idx) + "]." + memberName, UniformType::Float4, &vec);
 	}
 
 	void OpenGLShader::set4fv(int location, const glm::vec4& vec) const
 	{
-		glUseProgram(id);
-		glUniform4fv(location, 1, glm::value_ptr(vec));
+		setUniform(location, UniformType::Float4, &vec);
+	}
+
+	void OpenGLShader::set4f(const string& name, float v1, float v2, float v3, float v4) const
+	{
+		glm::vec4 vec(v1, v2, v3, v4);
+		setUniform(name, UniformType::Float4, &vec);
 	}
 
 	void OpenGLShader::set4f(int location, float v1, float v2, float v3, float v4) const
 	{
-		glUseProgram(id);
-		glUniform4f(location, v1, v2, v3, v4);
+		glm::vec4 vec(v1, v2, v3, v4);
+		setUniform(location, UniformType::Float4, &vec);
 	}
 
 	void OpenGLShader::set4fv_vector(const string& name, const vector<glm::vec4>& vec) const
 	{
-		glUseProgram(id);
-		for (size_t i = 0; i < vec.size(); i++)
-			set4fv(getUniformLocation(name + "[" + std::to_string(i) + "]"), vec[i]);
+		setUniform(name, UniformType::Float4, vec.data(), (uint32_t)vec.size());
 	}
 
 	void OpenGLShader::set4fv_vector(const string& name, const glm::vec4& vec, const unsigned int& size) const
 	{
-		glUseProgram(id);
-		for (size_t i = 0; i < size; i++)
-			set4fv(getUniformLocation(name + "[" + std::to_string(i) + "]"), vec);
+		vector<glm::vec4> values(size, vec);
+		setUniform(name, UniformType::Float4, values.data(), size);
 	}
 
 	void OpenGLShader::set4fv_vector(const string& listName, const string& memberName, const vector<glm::vec4>& vec) const
 	{
 		for (size_t i = 0; i < vec.size(); i++)
-			set4fv(getUniformLocation(listName + "[" + std::to_string(i) + "]." + memberName), vec[i]);
+			setUniform(listName + "[" + std::to_string(i) + "]." + memberName, UniformType::Float4, &vec[i]);
 	}
 
 	void OpenGLShader::set4fv_vector(const string& listName, const string& memberName, const glm::vec4& vec, const unsigned int& size) const
 	{
 		for (size_t i = 0; i < size; i++)
-			set4fv(getUniformLocation(listName + "[" + std::to_string(i) + "]." + memberName), vec);
+			setUniform(listName + "[" + std::to_string(i) + "]." + memberName, UniformType::Float4, &vec);
 	}
 
 	void OpenGLShader::setMat3fv(const string& name, const glm::mat3& mat, bool transpose) const
 	{
-		glUseProgram(id);
-		glUniformMatrix3fv(glGetUniformLocation(id, name.c_str()), 1, transpose, glm::value_ptr(mat));
+		const glm::mat3 value = transpose ? glm::transpose(mat) : mat;
+		setUniform(name, UniformType::Mat3, &value);
 	}
 
 	void OpenGLShader::setMat3fv(const string& listName, const string& memberName, const glm::mat3& mat, bool transpose) const
 	{
-		glUseProgram(id);
-		glUniformMatrix3fv(glGetUniformLocation(id, (listName + "." + memberName).c_str()), 1, transpose, glm::value_ptr(mat));
+		const glm::mat3 value = transpose ? glm::transpose(mat) : mat;
+		setUniform(listName + "." + memberName, UniformType::Mat3, &value);
 	}
 
 	void OpenGLShader::setMat3fv(const string& listName, const string& memberName, const glm::mat3& mat, const unsigned int& idx, bool transpose) const
 	{
-		glUseProgram(id);
-		glUniformMatrix3fv(getUniformBlockIndex(listName, memberName, idx), 1, transpose, glm::value_ptr(mat));
+		const glm::mat3 value = transpose ? glm::transpose(mat) : mat;
+		setUniform(listName + "[" + std::to_string(idx) + "]." + memberName, UniformType::Mat3, &value);
 	}
 
 	void OpenGLShader::setMat3fv(int location, const glm::mat3& mat, bool transpose) const
 	{
-		glUseProgram(id);
-		glUniformMatrix3fv(location, 1, transpose, glm::value_ptr(mat));
+		const glm::mat3 value = transpose ? glm::transpose(mat) : mat;
+		setUniform(location, UniformType::Mat3, &value);
 	}
 
 	void OpenGLShader::setMat3fv_vector(const string& name, const vector<glm::mat3>& vec, bool transpose) const
 	{
-		glUseProgram(id);
+		if (!transpose)
+		{
+			setUniform(name, UniformType::Mat3, vec.data(), (uint32_t)vec.size());
+			return;
+		}
+		
+		vector<glm::mat3> values(vec.size());
 		for (size_t i = 0; i < vec.size(); i++)
-			setMat3fv(getUniformLocation(name + "[" + std::to_string(i) + "]"), vec[i], transpose);
+			values[i] = glm::transpose(vec[i]);
+		setUniform(name, UniformType::Mat3, values.data(), (uint32_t)values.size());
 	}
 
 	void OpenGLShader::setMat3fv_vector(const string& name, const glm::mat3& mat, const unsigned int& size, bool transpose) const
 	{
-		glUseProgram(id);
-		for (size_t i = 0; i < size; i++)
-			setMat3fv(getUniformLocation(name + "[" + std::to_string(i) + "]"), mat, transpose);
+		vector<glm::mat3> values(size, transpose ? glm::transpose(mat) : mat);
+		setUniform(name, UniformType::Mat3, values.data(), size);
 	}
 
 	void OpenGLShader::setMat3fv_vector(const string& listName, const string& memberName, const vector<glm::mat3>& vec, bool transpose) const
 	{
-		glUseProgram(id);
 		for (size_t i = 0; i < vec.size(); i++)
-			setMat3fv(getUniformLocation(listName + "[" + std::to_string(i) + "]." + memberName), vec[i], transpose);
+		{
+			const glm::mat3 value = transpose ? glm::transpose(vec[i]) : vec[i];
+			setUniform(listName + "[" + std::to_string(i) + "]." + memberName, UniformType::Mat3, &value);
+		}
 	}
 
 	void OpenGLShader::setMat3fv_vector(const string& listName, const string& memberName, const glm::mat3& mat, const unsigned int& size, bool transpose) const
 	{
-		glUseProgram(id);
+		const glm::mat3 value = transpose ? glm::transpose(mat) : mat;
 		for (size_t i = 0; i < size; i++)
-			setMat3fv(getUniformLocation(listName + "[" + std::to_string(i) + "]." + memberName), mat, transpose);
+			setUniform(listName + "[" + std::to_string(i) + "]." + memberName, UniformType::Mat3, &value);
 	}
 
 	void OpenGLShader::setMat4fv(const string& name, const glm::mat4& mat, bool transpose) const
 	{
-		glUseProgram(id);
-		glUniformMatrix4fv(glGetUniformLocation(id, name.c_str()), 1, transpose, glm::value_ptr(mat));
+		const glm::mat4 value = transpose ? glm::transpose(mat) : mat;
+		setUniform(name, UniformType::Mat4, &value);
 	}
 
 	void OpenGLShader::setMat4fv(const string& listName, const string& memberName, const glm::mat4& mat, bool transpose) const
 	{
-		glUseProgram(id);
-		glUniformMatrix4fv(glGetUniformLocation(id, (listName + "." + memberName).c_str()), 1, transpose, glm::value_ptr(mat));
+		const glm::mat4 value = transpose ? glm::transpose(mat) : mat;
+		setUniform(listName + "." + memberName, UniformType::Mat4, &value);
 	}
 
 	void OpenGLShader::setMat4fv(const string& listName, const string& memberName, const glm::mat4& mat, const unsigned int& idx, bool transpose) const
 	{
-		glUseProgram(id);
-		glUniformMatrix4fv(getUniformBlockIndex(listName, memberName, idx), 1, transpose, glm::value_ptr(mat));
+		const glm::mat4 value = transpose ? glm::transpose(mat) : mat;
+		setUniform(listName + "[" + std::to_string(idx) + "]." + memberName, UniformType::Mat4, &value);
 	}
 
 	void OpenGLShader::setMat4fv(int location, const glm::mat4& mat, bool transpose) const
 	{
-		glUseProgram(id);
-		glUniformMatrix4fv(location, 1, transpose, glm::value_ptr(mat));
+		const glm::mat4 value = transpose ? glm::transpose(mat) : mat;
+		setUniform(location, UniformType::Mat4, &value);
 	}
 
 	void OpenGLShader::setMat4fv_vector(const string& name, const vector<glm::mat4>& vec, bool transpose) const
 	{
-		glUseProgram(id);
+		if (!transpose)
+		{
+			setUniform(name, UniformType::Mat4, vec.data(), (uint32_t)vec.size());
+			return;
+		}
+		
+		vector<glm::mat4> values(vec.size());
 		for (size_t i = 0; i < vec.size(); i++)
-			setMat4fv(getUniformLocation(name + "[" + std::to_string(i) + "]"), vec[i], transpose);
+			values[i] = glm::transpose(vec[i]);
+		setUniform(name, UniformType::Mat4, values.data(), (uint32_t)values.size());
 	}
 
 	void OpenGLShader::setMat4fv_vector(const string& name, const glm::mat4& mat, const unsigned int& size, bool transpose) const
 	{
-		glUseProgram(id);
-		for (size_t i = 0; i < size; i++)
-			setMat4fv(getUniformLocation(name + "[" + std::to_string(i) + "]"), mat, transpose);
+		vector<glm::mat4> values(size, transpose ? glm::transpose(mat) : mat);
+		setUniform(name, UniformType::Mat4, values.data(), size);
 	}
 
 	void OpenGLShader::setMat4fv_vector(const string& listName, const string& memberName, const vector<glm::mat4>& vec, bool transpose) const
 	{
-		glUseProgram(id);
 		for (size_t i = 0; i < vec.size(); i++)
-			setMat4fv(getUniformLocation(listName + "[" + std::to_string(i) + "]." + memberName), vec[i], transpose);
+		{
+			const glm::mat4 value = transpose ? glm::transpose(vec[i]) : vec[i];
+			setUniform(listName + "[" + std::to_string(i) + "]." + memberName, UniformType::Mat4, &value);
+		}
 	}
 
 	void OpenGLShader::setMat4fv_vector(const string& listName, const string& memberName, const glm::mat4& mat, const unsigned int& size, bool transpose) const
 	{
-		glUseProgram(id);
+		const glm::mat4 value = transpose ? glm::transpose(mat) : mat;
 		for (size_t i = 0; i < size; i++)
-			setMat4fv(getUniformLocation(listName + "[" + std::to_string(i) + "]." + memberName), mat, transpose);
+			setUniform(listName + "[" + std::to_string(i) + "]." + memberName, UniformType::Mat4, &value);
 	}
 
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 #include "Engine/Renderer/Shader.h"
 
+#include <chrono>
+#include <future>
+
 namespace Engine
 {
 	class OpenGLShader : public Shader
@@ -13,30 +16,109 @@ namespace Engine
 
 		unsigned int loadShader(const char* code, GLenum type, const char* fileName);
 		unsigned int loadShader(const char* fileName, GLenum type);
-		void loadShader(const char* fileName);
-		
-		void loadProgram(const std::unordered_map<GLenum, std::string>& shaderMap, const char* fileName);
 		void loadProgram(unsigned int vertexId, unsigned int fragmentId, unsigned int geometryId);
+
+		// Loading from a #type file runs in steps so that it can be spread out, see Shader::CreateAsync
+		enum class LoadState : uint8_t
+		{
+			Queued, Sourced, Linking, Ready
+		};
+		LoadState m_LoadState = LoadState::Ready;
+		string m_FilePath;
+		ShaderDefines m_Defines;
+		std::unordered_map<GLenum, std::string> m_Sources;
+
+		// A program being built from a #type file
+		struct ProgramBuild
+		{
+			unsigned int Program = 0;
+			std::vector<unsigned int> StageIDs;
+			uint64_t CacheKey = 0;
+			// Time spent waiting for the driver to compile and link, what the program cache saves the next run.
+			// Work the driver finishes in the background while frames go on is not counted.
+			float DriverMilliseconds = 0.f;
+			// Linked from the program cache, there is nothing to wait for
+			bool FromCache = false;
+		};
+		ProgramBuild m_Build;
+
+		// Hot reload: the file is read on another thread, then the new program builds next to the current one
+		std::future<std::unordered_map<GLenum, std::string>> m_ReloadSources;
+		bool m_ReloadAgain = false;
+		ProgramBuild m_ReloadBuild;
+
+		// Resolves includes, splits the #type stages and adds the defines to each
+		static std::unordered_map<GLenum, std::string> readSources(const char* fileName, const ShaderDefines& defines);
+		void beginBuild(ProgramBuild& build, const std::unordered_map<GLenum, std::string>& sources) const;
+		static bool isBuildComplete(const ProgramBuild& build);
+		// Reports errors and stores the program in the cache, true if it linked
+		bool endBuild(ProgramBuild& build) const;
+		static void discardBuild(ProgramBuild& build);
+		void submitProgram();
+		void finishProgram();
+		// Completes a deferred load, waiting for the driver if it has to
+		void ensureReady() const;
+
+		// Filled once after linking; Uniforms is the uniform table
+		ShaderReflection m_Reflection;
+		std::unordered_map<StringId, int> m_UniformIndices;
+		// Uniform index and array element of every location
+		struct UniformSlot
+		{
+			int Uniform = -1;
+			uint32_t Element = 0;
+		};
+		std::vector<UniformSlot> m_UniformSlots;
+		// Last uploaded values; a freshly linked program has all uniforms zeroed, as does this
+		mutable std::vector<uint8_t> m_UniformShadow;
+
+		// Binds the engine's blocks and fills m_Reflection
+		void reflect();
+		void reflectUniforms();
+		void reflectAttributes();
+		void reflectBlocks(GLenum programInterface, std::vector<ShaderBlockInfo>& blocks);
+		void bindUniformBlocks();
+		void setUniform(const string& name, UniformType type, const void* data, uint32_t count = 1) const;
+		void setUniform(int location, UniformType type, const void* data, uint32_t count = 1) const;
 	public:
 		OpenGLShader();
 		OpenGLShader(const OpenGLShader& shader);
 		OpenGLShader(const char* shaderFile);
+		struct DeferredLoad {};
+		// Only remembers the file, nothing is read or compiled until Submit or the first use
+		OpenGLShader(const char* shaderFile, DeferredLoad, const ShaderDefines& defines = ShaderDefines());
 		OpenGLShader(const char* vertexShaderFile, const char* fragmentShaderFile, const char* geometricShaderFile = nullptr);
 		OpenGLShader(int dummy, const char* shaderName, const char* vertexShaderCode, const char* fragmentShaderCode, const char* geometricShaderCode = nullptr);
 
 		const std::string& GetName() const override { return name; }
+		const std::string& GetFilePath() const override { return m_FilePath; }
+
+		void Bind() const override;
+		void Unbind() const override;
+
+		void LoadSources() override;
+		void Submit() override;
+		bool IsReady() const override;
+
+		void Reload() override;
+		bool UpdateReload() override;
 
 		void compile(const char* vertexShaderFile, const char* fragmentShaderFile, const char* geometricShaderFile = nullptr);
 		void compile(int dummy, const char* vertexShaderCode, const char* fragmentShaderCode, const char* geometricShaderCode = nullptr);
 		void compile_debug(const char* vertexSource, const char* fragmentSource, const char* geometrySource);
 		virtual ~OpenGLShader();
-		unsigned int getId()const { return id; }
+		unsigned int getId()const { ensureReady(); return id; }
 		void setId(unsigned int id) { this->id = id; }
 
 		void checkCompileErrors(unsigned int object, std::string type);
 		OpenGLShader& use();
 		//void bindTextures(Texture* textures);
 		//void bindTexture(Texture& texture, unsigned int idx);
+		const ShaderReflection& GetReflection() const override;
+		int FindUniform(StringId name) const override;
+		const UniformInfo& GetUniformInfo(int index) const override;
+		void SetUniform(int index, const void* data, uint32_t count = 1, uint32_t firstElement = 0) const override;
+
 		int getUniformLocation(const string& name) const override;
 		GLuint getUniformBlockIndex(const string& name) const override;
 		GLuint getUniformBlockIndex(const string& listName, const string& memberName, const unsigned int& idx) const override;
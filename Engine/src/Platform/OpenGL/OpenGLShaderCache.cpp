@@ -0,0 +1,199 @@
+#include "engine_pch.h"
+#include "OpenGLShaderCache.h"
+
+#include <glad/glad.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace Engine
+{
+	static const uint32_t CacheMagic = 0x48534745; // "EGSH"
+	// Bump when the entry layout changes
+	static const uint32_t CacheVersion = 1;
+
+	struct CacheHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint64_t Key;
+		uint32_t Format;
+		uint32_t Length;
+		float CompileMilliseconds;
+		uint32_t Padding;
+	};
+
+	struct ShaderCacheData
+	{
+		std::string Directory = "cache/shaders";
+		// Vendor, renderer and version, queried once a context is current
+		std::string DriverID;
+		// -1 until queried
+		int BinaryFormatCount = -1;
+		OpenGLShaderCache::Statistics Stats;
+	};
+
+	static ShaderCacheData s_data;
+
+	static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+	{
+		// FNV-1a
+		const uint8_t* bytes = (const uint8_t*)data;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 0x100000001b3ull;
+		}
+		return hash;
+	}
+
+	static std::string GetEntryPath(uint64_t key)
+	{
+		char fileName[32];
+		snprintf(fileName, sizeof(fileName), "%016llx.bin", (unsigned long long)key);
+		return (std::filesystem::path(s_data.Directory) / fileName).string();
+	}
+
+	static float MillisecondsSince(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	void OpenGLShaderCache::SetDirectory(const std::string& directory)
+	{
+		s_data.Directory = directory;
+	}
+
+	const std::string& OpenGLShaderCache::GetDirectory()
+	{
+		return s_data.Directory;
+	}
+
+	bool OpenGLShaderCache::IsSupported()
+	{
+		if (s_data.BinaryFormatCount < 0)
+		{
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &s_data.BinaryFormatCount);
+			if (!s_data.BinaryFormatCount)
+				EG_CORE_WARN("The driver supports no program binary formats, shaders will not be cached");
+		}
+		return s_data.BinaryFormatCount > 0;
+	}
+
+	uint64_t OpenGLShaderCache::ComputeKey(const std::unordered_map<GLenum, std::string>& sources)
+	{
+		if (s_data.DriverID.empty())
+		{
+			for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+			{
+				const char* value = (const char*)glGetString(name);
+				s_data.DriverID += value ? value : "";
+				s_data.DriverID += '\n';
+			}
+		}
+
+		uint64_t hash = 0xcbf29ce484222325ull;
+		hash = HashBytes(hash, s_data.DriverID.data(), s_data.DriverID.size());
+
+		// The map's iteration order is unspecified, hash the stages in a fixed order
+		std::vector<GLenum> stages;
+		stages.reserve(sources.size());
+		for (auto& kv : sources)
+			stages.push_back(kv.first);
+		std::sort(stages.begin(), stages.end());
+
+		for (GLenum stage : stages)
+		{
+			const std::string& source = sources.at(stage);
+			hash = HashBytes(hash, &stage, sizeof(stage));
+			hash = HashBytes(hash, source.data(), source.size());
+		}
+		return hash;
+	}
+
+	void OpenGLShaderCache::PrepareProgram(uint32_t program)
+	{
+		if (IsSupported())
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
+	bool OpenGLShaderCache::Load(uint32_t program, uint64_t key, const char* name)
+	{
+		if (!IsSupported())
+			return false;
+
+		auto start = std::chrono::steady_clock::now();
+
+		CacheHeader header;
+		std::vector<char> binary;
+		std::ifstream file(GetEntryPath(key), std::ios::binary);
+		if (file)
+		{
+			file.read((char*)&header, sizeof(header));
+			if (file && header.Magic == CacheMagic && header.Version == CacheVersion && header.Key == key)
+			{
+				binary.resize(header.Length);
+				file.read(binary.data(), header.Length);
+				if (!file)
+					binary.clear();
+			}
+		}
+
+		if (binary.empty())
+		{
+			s_data.Stats.Misses++;
+			EG_CORE_INFO("Shader cache miss: {0}", name);
+			return false;
+		}
+
+		// A rejected binary leaves the program unlinked, it can still be built from source
+		glProgramBinary(program, header.Format, binary.data(), (GLsizei)binary.size());
+		int success;
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		if (!success)
+		{
+			s_data.Stats.Misses++;
+			EG_CORE_WARN("Shader cache entry rejected by the driver: {0}", name);
+			return false;
+		}
+
+		float saved = std::max(header.CompileMilliseconds - MillisecondsSince(start), 0.f);
+		s_data.Stats.Hits++;
+		s_data.Stats.MillisecondsSaved += saved;
+		EG_CORE_INFO("Shader cache hit: {0} ({1:.1f} ms saved)", name, saved);
+		return true;
+	}
+
+	void OpenGLShaderCache::Save(uint32_t program, uint64_t key, const char* name, float compileMilliseconds)
+	{
+		if (!IsSupported())
+			return;
+
+		int length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+			return;
+
+		std::vector<char> binary(length);
+		GLenum format = 0;
+		glGetProgramBinary(program, length, &length, &format, binary.data());
+
+		std::error_code error;
+		std::filesystem::create_directories(s_data.Directory, error);
+		std::ofstream file(GetEntryPath(key), std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			EG_CORE_WARN("Unable to write shader cache entry for {0} to {1}", name, s_data.Directory);
+			return;
+		}
+
+		CacheHeader header = { CacheMagic, CacheVersion, key, format, (uint32_t)length, compileMilliseconds, 0 };
+		file.write((const char*)&header, sizeof(header));
+		file.write(binary.data(), length);
+	}
+
+	const OpenGLShaderCache::Statistics& OpenGLShaderCache::GetStats()
+	{
+		return s_data.Stats;
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+namespace Engine
+{
+	typedef unsigned int GLenum;
+
+	// On-disk cache of linked program binaries. Entries are keyed by the stage sources and the driver's
+	// vendor, renderer and version strings, so a driver update or an edited shader simply misses.
+	class OpenGLShaderCache
+	{
+	public:
+		// Directory the binaries are written to, relative to the working directory by default
+		static void SetDirectory(const std::string& directory);
+		static const std::string& GetDirectory();
+
+		static uint64_t ComputeKey(const std::unordered_map<GLenum, std::string>& sources);
+
+		// Must be called before linking a program that is going to be saved
+		static void PrepareProgram(uint32_t program);
+
+		// Tries to link the program from a cached binary, false if there is none or the driver rejects it
+		static bool Load(uint32_t program, uint64_t key, const char* name);
+		// Stores a successfully linked program; compileMilliseconds is reported as time saved on later hits
+		static void Save(uint32_t program, uint64_t key, const char* name, float compileMilliseconds);
+
+		struct Statistics
+		{
+			uint32_t Hits = 0;
+			uint32_t Misses = 0;
+			float MillisecondsSaved = 0.f;
+		};
+		static const Statistics& GetStats();
+	private:
+		static bool IsSupported();
+	};
+}
@@ -0,0 +1,248 @@
+#include "engine_pch.h"
+#include "OpenGLStateCache.h"
+
+#include <glad/glad.h>
+
+namespace Engine
+{
+	// Marks shadowed state that is not known, so the next change always reaches GL
+	static const uint32_t UnknownState = 0xffffffff;
+
+	enum BufferTarget : uint32_t
+	{
+		BufferTarget_Array = 0, BufferTarget_ElementArray, BufferTarget_DrawIndirect, BufferTarget_ShaderStorage, BufferTarget_Uniform,
+		BufferTarget_Count
+	};
+
+	struct OpenGLState
+	{
+		static constexpr uint32_t MaxTextureUnits = 32;
+		static constexpr uint32_t MaxBufferBases = 16;
+
+		uint32_t program = UnknownState;
+		uint32_t vertexArray = UnknownState;
+		uint32_t buffers[BufferTarget_Count];
+		uint32_t storageBufferBases[MaxBufferBases];
+		uint32_t uniformBufferBases[MaxBufferBases];
+		uint32_t textureUnits[MaxTextureUnits];
+
+		uint32_t blendEnabled = UnknownState;
+		uint32_t blendSource = UnknownState;
+		uint32_t blendDestination = UnknownState;
+		uint32_t depthTest = UnknownState;
+		uint32_t depthWrite = UnknownState;
+		int32_t viewport[4] = { -1, -1, -1, -1 };
+
+		OpenGLStateCache::Statistics stats;
+
+		OpenGLState() { Invalidate(); }
+
+		void Invalidate()
+		{
+			program = UnknownState;
+			vertexArray = UnknownState;
+			std::fill(std::begin(buffers), std::end(buffers), UnknownState);
+			std::fill(std::begin(storageBufferBases), std::end(storageBufferBases), UnknownState);
+			std::fill(std::begin(uniformBufferBases), std::end(uniformBufferBases), UnknownState);
+			std::fill(std::begin(textureUnits), std::end(textureUnits), UnknownState);
+			blendEnabled = blendSource = blendDestination = UnknownState;
+			depthTest = depthWrite = UnknownState;
+			std::fill(std::begin(viewport), std::end(viewport), -1);
+		}
+	};
+
+	static OpenGLState s_state;
+
+	// Counts the outcome and tells whether the call has to reach GL
+	static inline bool Changes(uint32_t& shadow, uint32_t value)
+	{
+		if (shadow == value)
+		{
+			s_state.stats.Hits++;
+			return false;
+		}
+		s_state.stats.Misses++;
+		shadow = value;
+		return true;
+	}
+
+	static uint32_t* GetBufferBinding(uint32_t target)
+	{
+		switch (target)
+		{
+		case GL_ARRAY_BUFFER:
+			return &s_state.buffers[BufferTarget_Array];
+		case GL_ELEMENT_ARRAY_BUFFER:
+			return &s_state.buffers[BufferTarget_ElementArray];
+		case GL_DRAW_INDIRECT_BUFFER:
+			return &s_state.buffers[BufferTarget_DrawIndirect];
+		case GL_SHADER_STORAGE_BUFFER:
+			return &s_state.buffers[BufferTarget_ShaderStorage];
+		case GL_UNIFORM_BUFFER:
+			return &s_state.buffers[BufferTarget_Uniform];
+		}
+		return nullptr;
+	}
+
+	void OpenGLStateCache::UseProgram(uint32_t program)
+	{
+		if (Changes(s_state.program, program))
+			glUseProgram(program);
+	}
+
+	void OpenGLStateCache::BindVertexArray(uint32_t vertexArray)
+	{
+		if (Changes(s_state.vertexArray, vertexArray))
+		{
+			glBindVertexArray(vertexArray);
+			s_state.buffers[BufferTarget_ElementArray] = UnknownState;
+		}
+	}
+
+	void OpenGLStateCache::BindBuffer(uint32_t target, uint32_t buffer)
+	{
+		uint32_t* binding = GetBufferBinding(target);
+		if (!binding)
+		{
+			s_state.stats.Misses++;
+			glBindBuffer(target, buffer);
+		}
+		else if (Changes(*binding, buffer))
+			glBindBuffer(target, buffer);
+	}
+
+	void OpenGLStateCache::BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer)
+	{
+		uint32_t* bases = target == GL_SHADER_STORAGE_BUFFER ? s_state.storageBufferBases : target == GL_UNIFORM_BUFFER ? s_state.uniformBufferBases : nullptr;
+		if (!bases || index >= OpenGLState::MaxBufferBases)
+		{
+			s_state.stats.Misses++;
+			glBindBufferBase(target, index, buffer);
+		}
+		else if (Changes(bases[index], buffer))
+			glBindBufferBase(target, index, buffer);
+		else
+			return;
+
+		if (uint32_t* binding = GetBufferBinding(target))
+			*binding = buffer;
+	}
+
+	void OpenGLStateCache::BindTextureUnit(uint32_t unit, uint32_t texture)
+	{
+		if (unit >= OpenGLState::MaxTextureUnits)
+		{
+			s_state.stats.Misses++;
+			glBindTextureUnit(unit, texture);
+		}
+		else if (Changes(s_state.textureUnits[unit], texture))
+			glBindTextureUnit(unit, texture);
+	}
+
+	void OpenGLStateCache::SetBlend(bool enabled, uint32_t sourceFactor, uint32_t destinationFactor)
+	{
+		if (Changes(s_state.blendEnabled, enabled))
+		{
+			if (enabled)
+				glEnable(GL_BLEND);
+			else
+				glDisable(GL_BLEND);
+		}
+		if (!enabled)
+			return;
+
+		// One call sets both factors, so it counts once
+		if (s_state.blendSource == sourceFactor && s_state.blendDestination == destinationFactor)
+			s_state.stats.Hits++;
+		else
+		{
+			s_state.stats.Misses++;
+			s_state.blendSource = sourceFactor;
+			s_state.blendDestination = destinationFactor;
+			glBlendFunc(sourceFactor, destinationFactor);
+		}
+	}
+
+	void OpenGLStateCache::SetDepthTest(bool enabled)
+	{
+		if (!Changes(s_state.depthTest, enabled))
+			return;
+		if (enabled)
+			glEnable(GL_DEPTH_TEST);
+		else
+			glDisable(GL_DEPTH_TEST);
+	}
+
+	void OpenGLStateCache::SetDepthWrite(bool enabled)
+	{
+		if (Changes(s_state.depthWrite, enabled))
+			glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+	}
+
+	void OpenGLStateCache::SetViewport(int32_t x, int32_t y, int32_t width, int32_t height)
+	{
+		int32_t* viewport = s_state.viewport;
+		if (viewport[0] == x && viewport[1] == y && viewport[2] == width && viewport[3] == height)
+		{
+			s_state.stats.Hits++;
+			return;
+		}
+		s_state.stats.Misses++;
+		viewport[0] = x;
+		viewport[1] = y;
+		viewport[2] = width;
+		viewport[3] = height;
+		glViewport(x, y, width, height);
+	}
+
+	static void Forget(uint32_t* bindings, size_t count, uint32_t object)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			if (bindings[i] == object)
+				bindings[i] = 0;
+		}
+	}
+
+	void OpenGLStateCache::OnProgramDeleted(uint32_t program)
+	{
+		if (s_state.program == program)
+			s_state.program = UnknownState;
+	}
+
+	void OpenGLStateCache::OnVertexArrayDeleted(uint32_t vertexArray)
+	{
+		if (s_state.vertexArray == vertexArray)
+		{
+			s_state.vertexArray = 0;
+			s_state.buffers[BufferTarget_ElementArray] = UnknownState;
+		}
+	}
+
+	void OpenGLStateCache::OnBufferDeleted(uint32_t buffer)
+	{
+		Forget(s_state.buffers, BufferTarget_Count, buffer);
+		Forget(s_state.storageBufferBases, OpenGLState::MaxBufferBases, buffer);
+		Forget(s_state.uniformBufferBases, OpenGLState::MaxBufferBases, buffer);
+	}
+
+	void OpenGLStateCache::OnTextureDeleted(uint32_t texture)
+	{
+		Forget(s_state.textureUnits, OpenGLState::MaxTextureUnits, texture);
+	}
+
+	void OpenGLStateCache::Invalidate()
+	{
+		s_state.Invalidate();
+	}
+
+	OpenGLStateCache::Statistics OpenGLStateCache::GetStats()
+	{
+		return s_state.stats;
+	}
+
+	void OpenGLStateCache::ResetStats()
+	{
+		s_state.stats = Statistics();
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+namespace Engine
+{
+	// Shadows the GL bindings and fixed function state the backend sets, so calls that would not change
+	// anything are skipped. Everything in Platform/OpenGL changes this state through here; code calling GL
+	// directly (the ImGui backend) must call Invalidate afterwards.
+	class OpenGLStateCache
+	{
+	public:
+		static void UseProgram(uint32_t program);
+		static void BindVertexArray(uint32_t vertexArray);
+		// Element array bindings belong to the bound vertex array and are tracked with it
+		static void BindBuffer(uint32_t target, uint32_t buffer);
+		// Indexed storage and uniform buffer bindings; these also set the target's generic binding
+		static void BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer);
+		static void BindTextureUnit(uint32_t unit, uint32_t texture);
+
+		static void SetBlend(bool enabled, uint32_t sourceFactor = 0, uint32_t destinationFactor = 0);
+		static void SetDepthTest(bool enabled);
+		static void SetDepthWrite(bool enabled);
+		static void SetViewport(int32_t x, int32_t y, int32_t width, int32_t height);
+
+		// GL unbinds deleted objects; the cache must too, or a recycled name would look bound already
+		static void OnProgramDeleted(uint32_t program);
+		static void OnVertexArrayDeleted(uint32_t vertexArray);
+		static void OnBufferDeleted(uint32_t buffer);
+		static void OnTextureDeleted(uint32_t texture);
+
+		// Forgets all shadowed state, so the next change of each kind reaches GL
+		static void Invalidate();
+
+		// Hits are calls skipped, misses calls that reached GL
+		struct Statistics
+		{
+			uint32_t Hits = 0;
+			uint32_t Misses = 0;
+		};
+		static Statistics GetStats();
+		static void ResetStats();
+	};
+}
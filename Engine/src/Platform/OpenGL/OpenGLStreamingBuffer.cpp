@@ -0,0 +1,130 @@
+#include "engine_pch.h"
+#include "OpenGLStreamingBuffer.h"
+#include "OpenGLStateCache.h"
+#include <glad/glad.h>
+
+namespace Engine
+{
+	OpenGLStreamingBuffer::OpenGLStreamingBuffer(uint32_t regionSize, uint32_t regionCount)
+		:m_RegionSize(regionSize), m_RegionCount(regionCount), m_Fences(regionCount, nullptr)
+	{
+		EG_CORE_ASSERT(regionCount > 0, "A streaming buffer needs at least one region!");
+		EG_CORE_ASSERT(GLAD_GL_VERSION_4_4, "Streaming buffers require glBufferStorage (OpenGL 4.4)!");
+
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		GLsizeiptr size = (GLsizeiptr)regionSize * regionCount;
+
+		glGenBuffers(1, &m_ID);
+		OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_ID);
+		glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+		m_MappedData = (uint8_t*)glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+		EG_CORE_ASSERT(m_MappedData, "Failed to map streaming buffer!");
+	}
+
+	OpenGLStreamingBuffer::~OpenGLStreamingBuffer()
+	{
+		for (GLsync fence : m_Fences)
+		{
+			if (fence)
+				glDeleteSync(fence);
+		}
+
+		OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_ID);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+		OpenGLStateCache::OnBufferDeleted(m_ID);
+		glDeleteBuffers(1, &m_ID);
+	}
+
+	void OpenGLStreamingBuffer::Bind() const
+	{
+		OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_ID);
+	}
+
+	void OpenGLStreamingBuffer::Unbind() const
+	{
+		OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void OpenGLStreamingBuffer::SetData(const void* data, uint32_t size)
+	{
+		void* dest = BeginWrite(size);
+		memcpy(dest, data, size);
+		EndWrite(size);
+	}
+
+	void* OpenGLStreamingBuffer::BeginWrite(uint32_t size)
+	{
+		EG_CORE_ASSERT(size <= m_RegionSize, "Write is larger than a streaming buffer region!");
+
+		// Base vertex draws need the data to start on a whole vertex
+		uint32_t stride = m_layout.GetStride() ? m_layout.GetStride() : 1;
+		uint32_t regionStart = m_Region * m_RegionSize;
+		uint32_t offset = (regionStart + m_RegionOffset + stride - 1) / stride * stride;
+
+		if (offset + size > regionStart + m_RegionSize)
+		{
+			NextRegion();
+			regionStart = m_Region * m_RegionSize;
+			offset = (regionStart + stride - 1) / stride * stride;
+			EG_CORE_ASSERT(offset + size <= regionStart + m_RegionSize, "Region size is not a multiple of the layout stride!");
+		}
+
+		m_RegionOffset = offset - regionStart;
+		m_WriteOffset = offset;
+		return m_MappedData + offset;
+	}
+
+	void OpenGLStreamingBuffer::EndWrite(uint32_t bytesWritten)
+	{
+		m_RegionOffset += bytesWritten;
+	}
+
+	uint32_t OpenGLStreamingBuffer::GetBaseVertex() const
+	{
+		uint32_t stride = m_layout.GetStride() ? m_layout.GetStride() : 1;
+		return m_WriteOffset / stride;
+	}
+
+	void OpenGLStreamingBuffer::EndFrame()
+	{
+		if (m_RegionOffset > 0)
+			NextRegion();
+	}
+
+	void OpenGLStreamingBuffer::NextRegion()
+	{
+		// Everything issued so far may read the region we are leaving
+		if (m_Fences[m_Region])
+			glDeleteSync(m_Fences[m_Region]);
+		m_Fences[m_Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_Region = (m_Region + 1) % m_RegionCount;
+		m_RegionOffset = 0;
+		WaitForRegion(m_Region);
+	}
+
+	void OpenGLStreamingBuffer::WaitForRegion(uint32_t region)
+	{
+		GLsync fence = m_Fences[region];
+		if (!fence)
+			return;
+
+		GLbitfield flags = 0;
+		while (true)
+		{
+			GLenum result = glClientWaitSync(fence, flags, 1000000);
+			if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+				break;
+			if (result == GL_WAIT_FAILED)
+			{
+				EG_CORE_ERROR("glClientWaitSync failed on streaming buffer region {0}", region);
+				break;
+			}
+			// The fence may not have been submitted yet
+			flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		}
+
+		glDeleteSync(fence);
+		m_Fences[region] = nullptr;
+	}
+}
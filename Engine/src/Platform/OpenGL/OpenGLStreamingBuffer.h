@@ -0,0 +1,52 @@
+#pragma once
+#include "Engine/Renderer/StreamingBuffer.h"
+
+typedef struct __GLsync* GLsync;
+
+namespace Engine
+{
+	// Backed by glBufferStorage with GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT; every region is
+	// guarded by a glFenceSync inserted when the buffer moves past it.
+	class OpenGLStreamingBuffer : public StreamingBuffer
+	{
+	public:
+		OpenGLStreamingBuffer(uint32_t regionSize, uint32_t regionCount);
+		virtual ~OpenGLStreamingBuffer();
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		// Streams a copy of data; draw it with GetBaseVertex()
+		virtual void SetData(const void* data, uint32_t size) override;
+
+		virtual void SetLayout(const BufferLayout& layout) override { m_layout = layout; }
+		virtual const BufferLayout& GetLayout() const override { return m_layout; }
+
+		virtual void* BeginWrite(uint32_t size) override;
+		virtual void EndWrite(uint32_t bytesWritten) override;
+
+		virtual uint32_t GetWriteOffset() const override { return m_WriteOffset; }
+		virtual uint32_t GetBaseVertex() const override;
+
+		virtual void EndFrame() override;
+
+		virtual uint32_t GetRegionSize() const override { return m_RegionSize; }
+		virtual uint32_t GetRegionCount() const override { return m_RegionCount; }
+	private:
+		void NextRegion();
+		void WaitForRegion(uint32_t region);
+	private:
+		uint32_t m_ID;
+		BufferLayout m_layout;
+
+		uint8_t* m_MappedData = nullptr;
+		uint32_t m_RegionSize;
+		uint32_t m_RegionCount;
+		std::vector<GLsync> m_Fences;
+
+		uint32_t m_Region = 0;
+		// Write cursor inside the current region
+		uint32_t m_RegionOffset = 0;
+		uint32_t m_WriteOffset = 0;
+	};
+}
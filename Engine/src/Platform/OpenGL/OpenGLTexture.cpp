@@ -2,42 +2,134 @@
 #include "OpenGLTexture.h"
 
 #include <stb_image.h>
+#include "OpenGLStateCache.h"
 #include <glad/glad.h>
 
 namespace Engine
 {
+	OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height, TextureFilter magFilter)
+		:m_Width(width), m_Height(height), m_InternalFormat(GL_RGBA8), m_DataFormat(GL_RGBA)
+	{
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_ID);
+		glTextureStorage2D(m_ID, 1, m_InternalFormat, m_Width, m_Height);
+
+		glTextureParameteri(m_ID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(m_ID, GL_TEXTURE_MAG_FILTER, magFilter == TextureFilter::Linear ? GL_LINEAR : GL_NEAREST);
+
+		glTextureParameteri(m_ID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTextureParameteri(m_ID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	}
+
 	OpenGLTexture2D::OpenGLTexture2D(const char* path)
 		:m_Path(path)
 	{
-		int width, height, channel;
-		stbi_set_flip_vertically_on_load(1);
-		stbi_uc* data = stbi_load(path, &width, &height, &channel, 0);
+		Image image = loadImage(m_Path);
+		EG_CORE_ASSERT(image.Pixels, "Failed to loat image!");
+		createTexture(image);
+		stbi_image_free(image.Pixels);
+	}
 
-		EG_CORE_ASSERT(data, "Failed to loat image!");
-		m_Width = width;
-		m_Height = height;
+	OpenGLTexture2D::Image OpenGLTexture2D::loadImage(const std::string& path)
+	{
+		// Also runs on reload threads, so the flip flag is set for the calling thread only
+		Image image;
+		stbi_set_flip_vertically_on_load_thread(1);
+		image.Pixels = stbi_load(path.c_str(), &image.Width, &image.Height, &image.Channels, 0);
+		return image;
+	}
+
+	void OpenGLTexture2D::createTexture(const Image& image)
+	{
+		m_Width = image.Width;
+		m_Height = image.Height;
 
 		GLenum dataFormatArray[]{ GL_FALSE, GL_RED, GL_RG, GL_RGB, GL_RGBA };
 		GLenum internalFormatArray[]{ GL_FALSE, GL_R8, GL_RG8, GL_RGB8, GL_RGBA8 };
 
+		m_InternalFormat = internalFormatArray[image.Channels];
+		m_DataFormat = dataFormatArray[image.Channels];
+
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_ID);
-		glTextureStorage2D(m_ID, 1, internalFormatArray[channel], width, height);
+		glTextureStorage2D(m_ID, 1, m_InternalFormat, m_Width, m_Height);
 
 		glTextureParameteri(m_ID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTextureParameteri(m_ID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-		glTextureSubImage2D(m_ID, 0, 0, 0, width, height, dataFormatArray[channel], GL_UNSIGNED_BYTE, data);
-
-		stbi_image_free(data);
+		glTextureSubImage2D(m_ID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, image.Pixels);
 	}
 
 	OpenGLTexture2D::~OpenGLTexture2D()
 	{
+		OpenGLStateCache::OnTextureDeleted(m_ID);
 		glDeleteTextures(1, &m_ID);
 	}
 
+	void OpenGLTexture2D::SetData(void* data, uint32_t size)
+	{
+		uint32_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
+		EG_CORE_ASSERT(size == m_Width * m_Height * bpp, "Data must be entire texture!");
+		glTextureSubImage2D(m_ID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+	}
+
 	void OpenGLTexture2D::Bind(uint32_t slot) const
 	{
-		glBindTextureUnit(slot, m_ID);
+		OpenGLStateCache::BindTextureUnit(slot, m_ID);
+	}
+
+	void OpenGLTexture2D::Reload()
+	{
+		if (m_Path.empty())
+			return;
+
+		// A decode still in flight restarts once it returns, waiting for it here would stall the frame
+		if (m_ReloadImage.valid())
+		{
+			m_ReloadAgain = true;
+			return;
+		}
+
+		std::string path = m_Path;
+		m_ReloadImage = std::async(std::launch::async, [path]() { return loadImage(path); });
+	}
+
+	bool OpenGLTexture2D::UpdateReload()
+	{
+		if (!m_ReloadImage.valid())
+			return true;
+		if (m_ReloadImage.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			return false;
+
+		Image image = m_ReloadImage.get();
+		if (m_ReloadAgain)
+		{
+			stbi_image_free(image.Pixels);
+			m_ReloadAgain = false;
+			Reload();
+			return false;
+		}
+
+		// A file caught in the middle of being written fails to decode, the next write triggers another reload
+		if (!image.Pixels || image.Channels < 1 || image.Channels > 4)
+		{
+			EG_CORE_WARN("Failed to decode {0}, keeping the previous image", m_Path);
+			stbi_image_free(image.Pixels);
+			return true;
+		}
+
+		GLenum dataFormatArray[]{ GL_FALSE, GL_RED, GL_RG, GL_RGB, GL_RGBA };
+		if ((uint32_t)image.Width == m_Width && (uint32_t)image.Height == m_Height && dataFormatArray[image.Channels] == m_DataFormat)
+			glTextureSubImage2D(m_ID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, image.Pixels);
+		else
+		{
+			// Immutable storage cannot be resized, the image moves to a new texture and GetRendererID changes
+			uint32_t previousID = m_ID;
+			createTexture(image);
+			OpenGLStateCache::OnTextureDeleted(previousID);
+			glDeleteTextures(1, &previousID);
+		}
+
+		stbi_image_free(image.Pixels);
+		EG_CORE_INFO("Reloaded texture {0}", m_Path);
+		return true;
 	}
 }
\ No newline at end of file
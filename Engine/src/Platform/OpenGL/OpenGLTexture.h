@@ -1,20 +1,49 @@
 #pragma once
 #include "Engine/Renderer/Texture.h"
 
+#include <future>
+
 namespace Engine
 {
 	class OpenGLTexture2D : public Texture2D
 	{
 	public:
+		OpenGLTexture2D(uint32_t width, uint32_t height, TextureFilter magFilter = TextureFilter::Nearest);
 		OpenGLTexture2D(const char* path);
 		~OpenGLTexture2D();
 
 		virtual uint32_t GetWidth() const override { return m_Width; }
 		virtual uint32_t GetHeight() const override { return m_Height; }
+		virtual uint32_t GetRendererID() const override { return m_ID; }
+		virtual const std::string& GetPath() const override { return m_Path; }
+
+		virtual void SetData(void* data, uint32_t size) override;
+
 		virtual void Bind(uint32_t slot) const override;
+
+		virtual void Reload() override;
+		virtual bool UpdateReload() override;
+
+		virtual bool operator==(const Texture& other) const override
+		{
+			return m_ID == other.GetRendererID();
+		}
 	private:
-		const char* m_Path;
+		struct Image
+		{
+			unsigned char* Pixels = nullptr;
+			int Width = 0, Height = 0, Channels = 0;
+		};
+		static Image loadImage(const std::string& path);
+		void createTexture(const Image& image);
+
+		std::string m_Path;
 		uint32_t m_Width, m_Height;
 		uint32_t m_ID;
+		uint32_t m_InternalFormat, m_DataFormat;
+
+		// Hot reload: the file is decoded on another thread and uploaded once it is done
+		std::future<Image> m_ReloadImage;
+		bool m_ReloadAgain = false;
 	};
 }
@@ -1,5 +1,6 @@
 #include "engine_pch.h"
 #include "OpenGLVertexArray.h"
+#include "OpenGLStateCache.h"
 #include <glad/glad.h>
 
 namespace Engine
@@ -22,43 +23,74 @@ namespace Engine
 			return GL_INT;
 		case Engine::ShaderDataType::Bool:
 			return GL_BOOL;
+		case Engine::ShaderDataType::Half2:
+		case Engine::ShaderDataType::Half4:
+			return GL_HALF_FLOAT;
+		case Engine::ShaderDataType::UByte4Norm:
+			return GL_UNSIGNED_BYTE;
+		case Engine::ShaderDataType::Short2Norm:
+			return GL_SHORT;
+		case Engine::ShaderDataType::UInt:
+			return GL_UNSIGNED_INT;
+		case Engine::ShaderDataType::RGB10A2:
+			return GL_UNSIGNED_INT_2_10_10_10_REV;
 		}
+		EG_CORE_ASSERT(false, "Unknown ShaderDataType!");
+		return 0;
 	}
 
 	OpenGLVertexArray::OpenGLVertexArray()
 	{
 		glGenVertexArrays(1, &m_ID);
-		glBindVertexArray(m_ID);
+		OpenGLStateCache::BindVertexArray(m_ID);
 	}
+	OpenGLVertexArray::~OpenGLVertexArray()
+	{
+		OpenGLStateCache::OnVertexArrayDeleted(m_ID);
+		glDeleteVertexArrays(1, &m_ID);
+	}
+
 	void OpenGLVertexArray::Bind() const
 	{
-		glBindVertexArray(m_ID);
+		OpenGLStateCache::BindVertexArray(m_ID);
 	}
 	void OpenGLVertexArray::Unbind() const
 	{
-		glBindVertexArray(0);
+		OpenGLStateCache::BindVertexArray(0);
 	}
 	
 	void OpenGLVertexArray::AddVertexBuffer(Ref<VertexBuffer>& vertexBuffer)
 	{
 		EG_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex buffer has no layout!");
 
-		glBindVertexArray(m_ID);
+		OpenGLStateCache::BindVertexArray(m_ID);
 		vertexBuffer->Bind();
-		uint32_t index = 0;
 		const auto& layout = vertexBuffer->GetLayout();
 		for (const auto& element : layout)
 		{
-			glEnableVertexAttribArray(index);
-			glVertexAttribPointer(index, element.GetComponentCount(), ShaderDataTypeToOpenGLBaseType(element.Type), element.Normalized ? GL_TRUE : GL_FALSE, layout.GetStride(), (const void*)element.Offset);
-			index++;
+			// Locations continue across vertex buffers; a matrix takes one location per column
+			uint32_t locationCount = element.GetLocationCount();
+			uint32_t componentCount = element.GetComponentCount() / locationCount;
+			uint32_t columnSize = element.Size / locationCount;
+			for (uint32_t column = 0; column < locationCount; column++)
+			{
+				const void* offset = (const void*)(uintptr_t)(element.Offset + columnSize * column);
+				glEnableVertexAttribArray(m_VertexBufferIndex);
+				if (element.IsInteger())
+					glVertexAttribIPointer(m_VertexBufferIndex, componentCount, ShaderDataTypeToOpenGLBaseType(element.Type), layout.GetStride(), offset);
+				else
+					glVertexAttribPointer(m_VertexBufferIndex, componentCount, ShaderDataTypeToOpenGLBaseType(element.Type), element.Normalized ? GL_TRUE : GL_FALSE, layout.GetStride(), offset);
+				glVertexAttribDivisor(m_VertexBufferIndex, element.Divisor);
+				m_VertexBufferIndex++;
+			}
 		}
 		m_VertexBuffers.push_back(vertexBuffer);
+		m_ValidatedShaders.clear();
 	}
 
 	void OpenGLVertexArray::SetIndexBuffer(Ref<IndexBuffer>& indexBuffer)
 	{
-		glBindVertexArray(m_ID);
+		OpenGLStateCache::BindVertexArray(m_ID);
 		indexBuffer->Bind();
 
 		m_IndexBuffer = indexBuffer;
@@ -7,7 +7,7 @@ namespace Engine
 	{
 	public:
 		OpenGLVertexArray();
-		~OpenGLVertexArray() {}
+		virtual ~OpenGLVertexArray();
 
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
@@ -19,6 +19,7 @@ namespace Engine
 		virtual Ref<IndexBuffer>& GetIndexBuffer() override { return m_IndexBuffer; }
 	private:
 		uint32_t m_ID;
+		uint32_t m_VertexBufferIndex = 0;
 		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
 		Ref<IndexBuffer> m_IndexBuffer;
 	};
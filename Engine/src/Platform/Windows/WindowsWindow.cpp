@@ -37,6 +37,11 @@ namespace Engine
 		m_context->SwapBuffers();
 	}
 
+	void WindowsWindow::PollEvents()
+	{
+		glfwPollEvents();
+	}
+
 	void WindowsWindow::SetVSync(bool enabled)
 	{
 		if (enabled)
@@ -62,6 +67,10 @@ namespace Engine
 			s_GLFWInitialized = true;
 		}
 
+		// Mesh shaders use gl_DrawID, which needs GLSL 4.60; without hints drivers may hand out an older context
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 		m_window = glfwCreateWindow(m_data.Width, m_data.Height, m_data.Title.c_str(), nullptr, nullptr);
 		m_context = new OpenGLContext(m_window);
 		m_context->Init();
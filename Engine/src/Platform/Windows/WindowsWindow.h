@@ -16,6 +16,7 @@ namespace Engine
 		virtual ~WindowsWindow();
 
 		void OnUpdate() override;
+		void PollEvents() override;
 
 		unsigned int GetWidth() const override { return m_data.Width; }
 		unsigned int GetHeight() const override { return m_data.Height; }
@@ -26,6 +27,7 @@ namespace Engine
 		bool IsVSync() const override { return m_data.VSync; }
 
 		virtual void* GetNativeWindow() const { return m_window; }
+		virtual GraphicsContext* GetContext() const override { return m_context; }
 	private:
 		virtual void Init(const WindowProps& props);
 		virtual void Shutdown();
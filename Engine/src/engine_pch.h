@@ -5,6 +5,7 @@
 #include <functional>
 #include <algorithm>
 #include <utility>
+#include <array>
 
 #include <string>
 #include <sstream>
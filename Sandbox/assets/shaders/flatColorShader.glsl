@@ -2,7 +2,7 @@
 #version 440 core
 layout(location = 0) in vec3 position;
 
-uniform mat4 viewProjMat;
+#include "include/sceneData.glsl"
 uniform mat4 modelMat;
 
 void main()
@@ -0,0 +1,44 @@
+#type vertex
+#version 440 core
+
+struct Particle
+{
+	vec4 PositionVelocity;
+	vec4 Color;
+	vec4 ColorVelocity;
+	// Size, size velocity, rotation, angular velocity
+	vec4 SizeRotation;
+	vec4 Life;
+};
+
+layout(std430, binding = 0) readonly buffer Particles { Particle u_Particles[]; };
+
+out vec4 v_Color;
+#include "include/sceneData.glsl"
+
+const vec2 c_Corners[6] = vec2[6](
+	vec2(-.5f, -.5f), vec2(.5f, -.5f), vec2(.5f, .5f),
+	vec2(.5f, .5f), vec2(-.5f, .5f), vec2(-.5f, -.5f)
+);
+
+void main()
+{
+	Particle particle = u_Particles[gl_InstanceID];
+	float c = cos(particle.SizeRotation.z);
+	float s = sin(particle.SizeRotation.z);
+	vec2 corner = c_Corners[gl_VertexID] * particle.SizeRotation.x;
+	vec2 position = particle.PositionVelocity.xy + vec2(c * corner.x - s * corner.y, s * corner.x + c * corner.y);
+
+	gl_Position = viewProjMat * vec4(position, 0.f, 1.f);
+	v_Color = particle.Color;
+}
+
+#type fragment
+#version 440 core
+
+in vec4 v_Color;
+
+void main()
+{
+	gl_FragColor = v_Color;
+}
@@ -0,0 +1,65 @@
+#type compute
+#version 440 core
+layout(local_size_x = 256) in;
+
+struct Particle
+{
+	vec4 PositionVelocity;
+	vec4 Color;
+	vec4 ColorVelocity;
+	// Size, size velocity, rotation, angular velocity
+	vec4 SizeRotation;
+	vec4 Life;
+};
+
+struct DrawCommand
+{
+	uint Count;
+	uint InstanceCount;
+	uint First;
+	uint BaseInstance;
+};
+
+layout(std430, binding = 0) readonly buffer InputParticles { Particle u_Input[]; };
+layout(std430, binding = 1) writeonly buffer OutputParticles { Particle u_Output[]; };
+layout(std430, binding = 2) buffer DrawCommands { DrawCommand u_Commands[]; };
+layout(std430, binding = 3) readonly buffer EmittedParticles { Particle u_Emitted[]; };
+
+uniform float u_DeltaTime;
+uniform int u_Capacity;
+uniform int u_EmitCount;
+uniform int u_InputCommand;
+uniform int u_OutputCommand;
+
+void Append(Particle particle)
+{
+	uint index = atomicAdd(u_Commands[u_OutputCommand].InstanceCount, 1u);
+	if (index < uint(u_Capacity))
+		u_Output[index] = particle;
+	else
+		atomicAdd(u_Commands[u_OutputCommand].InstanceCount, 0xffffffffu);
+}
+
+void main()
+{
+	uint i = gl_GlobalInvocationID.x;
+	if (i < uint(u_Capacity))
+	{
+		if (i >= u_Commands[u_InputCommand].InstanceCount)
+			return;
+
+		Particle particle = u_Input[i];
+		particle.Life.x -= u_DeltaTime;
+		if (particle.Life.x <= 0.f)
+			return;
+
+		particle.PositionVelocity.xy += particle.PositionVelocity.zw * u_DeltaTime;
+		particle.Color += particle.ColorVelocity * u_DeltaTime;
+		particle.SizeRotation.xz += particle.SizeRotation.yw * u_DeltaTime;
+		Append(particle);
+	}
+	else if (i - uint(u_Capacity) < uint(u_EmitCount))
+	{
+		Append(u_Emitted[i - uint(u_Capacity)]);
+	}
+}
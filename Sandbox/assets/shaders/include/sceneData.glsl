@@ -0,0 +1,5 @@
+// Camera data shared by every engine shader, bound to Shader::SceneDataBinding
+layout(std140) uniform SceneData
+{
+	mat4 viewProjMat;
+};
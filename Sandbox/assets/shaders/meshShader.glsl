@@ -0,0 +1,24 @@
+#type vertex
+#version 460 core
+layout(location = 0) in vec3 position;
+
+// Model matrices of the meshes queued with Renderer::Submit, one per draw of the multi-draw
+layout(std430, binding = 0) readonly buffer DrawData { mat4 u_ModelMats[]; };
+
+#include "include/sceneData.glsl"
+uniform int u_DrawOffset;
+
+void main()
+{
+	gl_Position = viewProjMat * u_ModelMats[u_DrawOffset + gl_DrawID] * vec4(position, 1.f);
+}
+
+#type fragment
+#version 460 core
+
+uniform vec4 color;
+
+void main()
+{
+	gl_FragColor = color;
+}
@@ -0,0 +1,30 @@
+#type vertex
+#version 440 core
+layout(location = 0) in vec2 a_Corner;
+// Per instance: position x, y, size and rotation
+layout(location = 1) in vec4 a_Transform;
+layout(location = 2) in vec4 a_Color;
+
+out vec4 v_Color;
+#include "include/sceneData.glsl"
+
+void main()
+{
+	float c = cos(a_Transform.w);
+	float s = sin(a_Transform.w);
+	vec2 corner = a_Corner * a_Transform.z;
+	vec2 position = a_Transform.xy + vec2(c * corner.x - s * corner.y, s * corner.x + c * corner.y);
+
+	gl_Position = viewProjMat * vec4(position, 0.f, 1.f);
+	v_Color = a_Color;
+}
+
+#type fragment
+#version 440 core
+
+in vec4 v_Color;
+
+void main()
+{
+	gl_FragColor = v_Color;
+}
@@ -0,0 +1,76 @@
+#type vertex
+#version 440 core
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+// Texture slot and tiling factor
+layout(location = 3) in vec2 a_TexParams;
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+flat out int v_TexIndex;
+#include "include/sceneData.glsl"
+
+void main()
+{
+	gl_Position = viewProjMat * vec4(a_Position, 1.f);
+	v_Color = a_Color;
+	v_TexCoord = a_TexCoord;
+	v_TexIndex = int(a_TexParams.x);
+}
+
+#type fragment
+#version 440 core
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+flat in int v_TexIndex;
+uniform sampler2D u_Textures[32];
+
+void main()
+{
+	// The glyph atlas stores the signed distance to the glyph edge in alpha, 0.5 being the edge
+	float distance = 0.f;
+	switch (v_TexIndex)
+	{
+		case  0: distance = texture(u_Textures[ 0], v_TexCoord).a; break;
+		case  1: distance = texture(u_Textures[ 1], v_TexCoord).a; break;
+		case  2: distance = texture(u_Textures[ 2], v_TexCoord).a; break;
+		case  3: distance = texture(u_Textures[ 3], v_TexCoord).a; break;
+		case  4: distance = texture(u_Textures[ 4], v_TexCoord).a; break;
+		case  5: distance = texture(u_Textures[ 5], v_TexCoord).a; break;
+		case  6: distance = texture(u_Textures[ 6], v_TexCoord).a; break;
+		case  7: distance = texture(u_Textures[ 7], v_TexCoord).a; break;
+		case  8: distance = texture(u_Textures[ 8], v_TexCoord).a; break;
+		case  9: distance = texture(u_Textures[ 9], v_TexCoord).a; break;
+		case 10: distance = texture(u_Textures[10], v_TexCoord).a; break;
+		case 11: distance = texture(u_Textures[11], v_TexCoord).a; break;
+		case 12: distance = texture(u_Textures[12], v_TexCoord).a; break;
+		case 13: distance = texture(u_Textures[13], v_TexCoord).a; break;
+		case 14: distance = texture(u_Textures[14], v_TexCoord).a; break;
+		case 15: distance = texture(u_Textures[15], v_TexCoord).a; break;
+		case 16: distance = texture(u_Textures[16], v_TexCoord).a; break;
+		case 17: distance = texture(u_Textures[17], v_TexCoord).a; break;
+		case 18: distance = texture(u_Textures[18], v_TexCoord).a; break;
+		case 19: distance = texture(u_Textures[19], v_TexCoord).a; break;
+		case 20: distance = texture(u_Textures[20], v_TexCoord).a; break;
+		case 21: distance = texture(u_Textures[21], v_TexCoord).a; break;
+		case 22: distance = texture(u_Textures[22], v_TexCoord).a; break;
+		case 23: distance = texture(u_Textures[23], v_TexCoord).a; break;
+		case 24: distance = texture(u_Textures[24], v_TexCoord).a; break;
+		case 25: distance = texture(u_Textures[25], v_TexCoord).a; break;
+		case 26: distance = texture(u_Textures[26], v_TexCoord).a; break;
+		case 27: distance = texture(u_Textures[27], v_TexCoord).a; break;
+		case 28: distance = texture(u_Textures[28], v_TexCoord).a; break;
+		case 29: distance = texture(u_Textures[29], v_TexCoord).a; break;
+		case 30: distance = texture(u_Textures[30], v_TexCoord).a; break;
+		case 31: distance = texture(u_Textures[31], v_TexCoord).a; break;
+	}
+
+	// Smooth over about one pixel at any scale
+	float width = max(fwidth(distance), 1e-4f);
+	float alpha = smoothstep(0.5f - width, 0.5f + width, distance);
+	if (alpha <= 0.f)
+		discard;
+	gl_FragColor = vec4(v_Color.rgb, v_Color.a * alpha);
+}
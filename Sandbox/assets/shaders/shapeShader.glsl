@@ -0,0 +1,53 @@
+#type vertex
+#version 440 core
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_LocalPosition;
+layout(location = 3) in vec2 a_HalfSize;
+layout(location = 4) in vec2 a_Stroke;
+
+out vec4 v_Color;
+out vec2 v_LocalPosition;
+flat out vec2 v_HalfSize;
+flat out vec2 v_Stroke;
+#include "include/sceneData.glsl"
+
+void main()
+{
+	gl_Position = viewProjMat * vec4(a_Position, 1.f);
+	v_Color = a_Color;
+	v_LocalPosition = a_LocalPosition;
+	v_HalfSize = a_HalfSize;
+	v_Stroke = a_Stroke;
+}
+
+#type fragment
+#version 440 core
+
+in vec4 v_Color;
+in vec2 v_LocalPosition;
+flat in vec2 v_HalfSize;
+// x: outline thickness, 0 when filled; y: corner radius
+flat in vec2 v_Stroke;
+
+// Signed distance to a box with rounded corners, negative inside
+float RoundedBoxDistance(vec2 p, vec2 halfSize, float radius)
+{
+	vec2 q = abs(p) - halfSize + radius;
+	return length(max(q, 0.f)) + min(max(q.x, q.y), 0.f) - radius;
+}
+
+void main()
+{
+	float distance = RoundedBoxDistance(v_LocalPosition, v_HalfSize, v_Stroke.y);
+	// Keep only the band of the given thickness inside the edge
+	if (v_Stroke.x > 0.f)
+		distance = max(distance, -(distance + v_Stroke.x));
+
+	// Smooth over about one pixel at any zoom
+	float width = max(fwidth(distance), 1e-6f);
+	float alpha = clamp(0.5f - distance / width, 0.f, 1.f);
+	if (alpha <= 0.f)
+		discard;
+	gl_FragColor = vec4(v_Color.rgb, v_Color.a * alpha);
+}
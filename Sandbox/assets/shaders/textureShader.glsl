@@ -1,25 +1,76 @@
 #type vertex
 #version 440 core
-layout(location = 0) in vec3 position;
-layout(location = 1) in vec2 TexCoord;
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+// Texture slot and tiling factor
+layout(location = 3) in vec2 a_TexParams;
 
-out vec2 texCoord;
-uniform mat4 viewProjMat;
-uniform mat4 modelMat;
+out vec4 v_Color;
+out vec2 v_TexCoord;
+flat out int v_TexIndex;
+#include "include/sceneData.glsl"
 
 void main()
 {
-	gl_Position = viewProjMat * modelMat * vec4(position, 1.f);
-	texCoord = TexCoord;
+	gl_Position = viewProjMat * vec4(a_Position, 1.f);
+	v_Color = a_Color;
+	v_TexCoord = a_TexCoord * a_TexParams.y;
+	v_TexIndex = int(a_TexParams.x);
 }
 
 #type fragment
 #version 440 core
 
-in vec2 texCoord;
-uniform sampler2D u_texture;
+in vec4 v_Color;
+in vec2 v_TexCoord;
+flat in int v_TexIndex;
+uniform sampler2D u_Textures[32];
 
 void main()
 {
-	gl_FragColor = texture(u_texture, texCoord);
-}
\ No newline at end of file
+	// Sampler arrays may only be indexed with dynamically uniform expressions,
+	// so the slot is selected through a switch instead of u_Textures[v_TexIndex]
+	vec4 texColor = v_Color;
+	switch (v_TexIndex)
+	{
+		case  0: texColor *= texture(u_Textures[ 0], v_TexCoord); break;
+		case  1: texColor *= texture(u_Textures[ 1], v_TexCoord); break;
+		case  2: texColor *= texture(u_Textures[ 2], v_TexCoord); break;
+		case  3: texColor *= texture(u_Textures[ 3], v_TexCoord); break;
+		case  4: texColor *= texture(u_Textures[ 4], v_TexCoord); break;
+		case  5: texColor *= texture(u_Textures[ 5], v_TexCoord); break;
+		case  6: texColor *= texture(u_Textures[ 6], v_TexCoord); break;
+		case  7: texColor *= texture(u_Textures[ 7], v_TexCoord); break;
+		case  8: texColor *= texture(u_Textures[ 8], v_TexCoord); break;
+		case  9: texColor *= texture(u_Textures[ 9], v_TexCoord); break;
+		case 10: texColor *= texture(u_Textures[10], v_TexCoord); break;
+		case 11: texColor *= texture(u_Textures[11], v_TexCoord); break;
+		case 12: texColor *= texture(u_Textures[12], v_TexCoord); break;
+		case 13: texColor *= texture(u_Textures[13], v_TexCoord); break;
+		case 14: texColor *= texture(u_Textures[14], v_TexCoord); break;
+		case 15: texColor *= texture(u_Textures[15], v_TexCoord); break;
+		case 16: texColor *= texture(u_Textures[16], v_TexCoord); break;
+		case 17: texColor *= texture(u_Textures[17], v_TexCoord); break;
+		case 18: texColor *= texture(u_Textures[18], v_TexCoord); break;
+		case 19: texColor *= texture(u_Textures[19], v_TexCoord); break;
+		case 20: texColor *= texture(u_Textures[20], v_TexCoord); break;
+		case 21: texColor *= texture(u_Textures[21], v_TexCoord); break;
+		case 22: texColor *= texture(u_Textures[22], v_TexCoord); break;
+		case 23: texColor *= texture(u_Textures[23], v_TexCoord); break;
+		case 24: texColor *= texture(u_Textures[24], v_TexCoord); break;
+		case 25: texColor *= texture(u_Textures[25], v_TexCoord); break;
+		case 26: texColor *= texture(u_Textures[26], v_TexCoord); break;
+		case 27: texColor *= texture(u_Textures[27], v_TexCoord); break;
+		case 28: texColor *= texture(u_Textures[28], v_TexCoord); break;
+		case 29: texColor *= texture(u_Textures[29], v_TexCoord); break;
+		case 30: texColor *= texture(u_Textures[30], v_TexCoord); break;
+		case 31: texColor *= texture(u_Textures[31], v_TexCoord); break;
+	}
+#ifdef ALPHA_CUTOUT
+	// Opaque quads write depth, texels that would be see-through are dropped rather than hiding what is behind
+	if (texColor.a < .5f)
+		discard;
+#endif
+	gl_FragColor = texColor;
+}
@@ -0,0 +1,29 @@
+#type vertex
+#version 440 core
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec2 a_TexCoord;
+
+#include "include/sceneData.glsl"
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	v_TexCoord = a_TexCoord;
+	gl_Position = viewProjMat * vec4(a_Position, 1.f);
+}
+
+#type fragment
+#version 440 core
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Texture;
+
+void main()
+{
+	vec4 color = texture(u_Texture, v_TexCoord);
+	if (color.a == 0.f)
+		discard;
+	gl_FragColor = color;
+}
@@ -5,6 +5,21 @@
 #include <Platform/OpenGL/OpenGLShader.h>
 #include <glm/gtc/type_ptr.hpp>
 
+// Applied on the render thread, where the square shader may be used directly
+struct SquareColor
+{
+	const Engine::Shader* SquareShader;
+	glm::vec4 Color;
+};
+
+static Engine::CachedUniform<glm::vec4> s_ColorUniform(Engine::StringId("color"));
+
+static void SetSquareColor(const SquareColor& color)
+{
+	color.SquareShader->Bind();
+	s_ColorUniform.Set(*color.SquareShader, color.Color);
+}
+
 Sandbox2D::Sandbox2D()
 	:Layer("Sandbox2D"), m_CameraController((float)Engine::Application::Get().GetWindow().GetWidth() / (float)Engine::Application::Get().GetWindow().GetHeight())
 {
@@ -12,6 +27,45 @@ Sandbox2D::Sandbox2D()
 
 void Sandbox2D::OnAttach()
 {
+	m_CheckerboardTexture = Engine::Texture2D::Create("assets/textures/Checkerboard.png");
+	m_FaceTexture = Engine::Texture2D::Create("assets/textures/awesomeface.png");
+
+	// Created up front, resources cannot be created while recording for the render thread
+	m_shader = Engine::Shader::Create("assets/shaders/flatColorShader.glsl");
+	m_SquareVA = Engine::VertexArray::Create();
+	float squareVertices[4 * 3] = {
+		-.5f, -.5f, 0.f,
+		 .5f, -.5f, 0.f,
+		 .5f,  .5f, 0.f,
+		-.5f,  .5f, 0.f
+	};
+	Engine::Ref<Engine::VertexBuffer> squareVB;
+	squareVB.reset(Engine::VertexBuffer::Create(squareVertices, sizeof(squareVertices)));
+	squareVB->SetLayout({ { Engine::ShaderDataType::Float3, "position" } });
+	m_SquareVA->AddVertexBuffer(squareVB);
+	uint32_t squareIndices[6] = { 0, 1, 2, 2, 3, 0 };
+	Engine::Ref<Engine::IndexBuffer> squareIB;
+	squareIB.reset(Engine::IndexBuffer::Create(squareIndices, 6));
+	m_SquareVA->SetIndexBuffer(squareIB);
+
+	// A large field of faces around the scene, using the face texture as a one-cell tileset
+	m_Tilemap.reset(new Engine::Tilemap(256, 256, m_FaceTexture, 1, 1, glm::vec3{ -64.f, -64.f, -.5f }, .5f));
+	for (uint32_t y = 0; y < m_Tilemap->GetHeight(); y++)
+		for (uint32_t x = 0; x < m_Tilemap->GetWidth(); x++)
+			if ((x + y) % 3 == 0)
+				m_Tilemap->SetTile(x, y, 0);
+
+	m_ParticleSystem.reset(new Engine::ParticleSystem(100000));
+	m_GPUParticleSystem.reset(new Engine::GPUParticleSystem(100000));
+	m_Particle.Position = { 0.f, -2.f };
+	m_Particle.Velocity = { 0.f, 2.f };
+	m_Particle.VelocityVariation = { 3.f, 1.f };
+	m_Particle.ColorBegin = { 254 / 255.f, 212 / 255.f, 123 / 255.f, 1.f };
+	m_Particle.ColorEnd = { 254 / 255.f, 109 / 255.f, 41 / 255.f, 0.f };
+	m_Particle.SizeBegin = .1f;
+	m_Particle.SizeVariation = .05f;
+	m_Particle.AngularVelocityVariation = 3.f;
+	m_Particle.LifeTime = 2.f;
 }
 
 void Sandbox2D::OnDetach()
@@ -22,22 +76,128 @@ void Sandbox2D::OnUpdate(Engine::Timestep ts)
 {
 	m_CameraController.onUpdate(ts);
 
+	if (Engine::RenderCommand::IsRecording())
+	{
+		DrawRecorded();
+		return;
+	}
+
+	Engine::Renderer2D::ResetStats();
+	Engine::RenderCommand::ResetStateCacheStats();
 	Engine::RenderCommand::SetClearColor({ 0, 0, 0, 1 });
 	Engine::RenderCommand::Clear();
 
+	m_Tilemap->Render(m_CameraController.getCamera());
+
 	Engine::Renderer2D::BeginScene(m_CameraController.getCamera());
+	Engine::Renderer2D::SetBlendMode(Engine::BlendMode::Opaque);
+	Engine::Renderer2D::DrawQuad(glm::vec3{ 0.f, 0.f, -.1f }, glm::vec2{ 10.f, 10.f }, m_CheckerboardTexture, 10.f);
+	Engine::Renderer2D::SetBlendMode(Engine::BlendMode::Alpha);
 	Engine::Renderer2D::DrawQuad(glm::vec2{ 0.f, 0.f }, glm::vec2{ 1.f,1.f }, m_SquareCol);
+	Engine::Renderer2D::DrawQuad(glm::vec2{ 1.5f, 0.f }, glm::vec2{ 1.f,1.f }, m_FaceTexture);
+	Engine::Renderer2D::DrawRotatedQuad(glm::vec2{ -1.5f, 0.f }, glm::vec2{ .8f, .8f }, glm::radians(45.f), m_FaceTexture);
+	Engine::Renderer2D::DrawCircle(glm::vec3{ 0.f, 1.5f, 0.f }, .5f, m_SquareCol);
+	Engine::Renderer2D::DrawCircle(glm::vec3{ 1.5f, 1.5f, 0.f }, .5f, { .2f, .8f, .3f, 1.f }, .08f);
+	Engine::Renderer2D::DrawRect(glm::vec3{ -1.5f, 1.5f, 0.f }, glm::vec2{ 1.f, .8f }, { .8f, .3f, .2f, 1.f }, .05f, .15f);
+	Engine::Renderer2D::DrawLine(glm::vec3{ -2.f, -1.f, 0.f }, glm::vec3{ 2.f, -1.f, 0.f }, .05f, { 1.f, 1.f, 1.f, 1.f });
 	Engine::Renderer2D::EndScene();
+
+	m_ParticleSystem->Emit(m_Particle, 100);
+	m_ParticleSystem->OnUpdate(ts);
+	m_ParticleSystem->OnRender(m_CameraController.getCamera());
+
+	if (m_CompareGPUParticles)
+	{
+		// The same stream one unit to the right; ages match, so the counts may only differ by the
+		// particles of a frame whose last moment rounds differently on either side
+		Engine::ParticleProps particle = m_Particle;
+		particle.Position.x += 1.f;
+		m_GPUParticleSystem->Emit(particle, 100);
+		m_GPUParticleSystem->OnUpdate(ts);
+		m_GPUParticleSystem->OnRender(m_CameraController.getCamera());
+
+		// Stalls on the GPU, which is fine for a debug comparison
+		m_GPUParticleCount = m_GPUParticleSystem->ReadParticleCount();
+		uint32_t cpuCount = m_ParticleSystem->GetParticleCount();
+		uint32_t difference = cpuCount > m_GPUParticleCount ? cpuCount - m_GPUParticleCount : m_GPUParticleCount - cpuCount;
+		if (difference > 100)
+			EG_WARN("GPU particle count {0} differs from the CPU count {1}", m_GPUParticleCount, cpuCount);
+	}
+}
+
+void Sandbox2D::DrawRecorded()
+{
+	Engine::RenderCommand::SetClearColor({ .1f, .1f, .1f, 1 });
+	Engine::RenderCommand::Clear();
+
+	Engine::Renderer::BeginScene(m_CameraController.getCamera());
+	Engine::RenderCommand::Retain(m_shader);
+	Engine::RenderCommand::Submit(SetSquareColor, { m_shader.get(), m_SquareCol });
+	for (int y = -10; y < 10; y++)
+	{
+		for (int x = -10; x < 10; x++)
+		{
+			glm::mat4 transform = glm::translate(glm::mat4(1.f), glm::vec3{ x * .25f, y * .25f, 0.f }) * glm::scale(glm::mat4(1.f), glm::vec3(.2f));
+			Engine::Renderer::Submit(m_SquareVA, m_shader, transform);
+		}
+	}
+	Engine::Renderer::EndScene();
 }
 
 void Sandbox2D::OnImGuiRender()
 {
 	ImGui::Begin("Settings");
+	ImGui::Text("F2 switches to recording for a render thread and back");
 	ImGui::ColorEdit3("Square Color", glm::value_ptr(m_SquareCol));
+
+	auto stats = Engine::Renderer2D::GetStats();
+	ImGui::Text("Renderer2D Stats:");
+	ImGui::Text("Draw Calls: %d", stats.DrawCalls);
+	ImGui::Text("Quads: %d", stats.QuadCount);
+	ImGui::Text("Culled Quads: %d", stats.CulledQuadCount);
+	ImGui::Text("Vertices: %d", stats.GetTotalVertexCount());
+	ImGui::Text("Indices: %d", stats.GetTotalIndexCount());
+
+	ImGui::Text("Particles: %d", m_ParticleSystem->GetParticleCount());
+	if (ImGui::Checkbox("Compare GPU Particles", &m_CompareGPUParticles) && m_CompareGPUParticles)
+	{
+		// Both systems start empty so their counts line up
+		m_ParticleSystem.reset(new Engine::ParticleSystem(100000));
+		m_GPUParticleSystem.reset(new Engine::GPUParticleSystem(100000));
+	}
+	if (m_CompareGPUParticles)
+		ImGui::Text("GPU Particles: %d", m_GPUParticleCount);
+
+	auto cacheStats = Engine::RenderCommand::GetStateCacheStats();
+	ImGui::Text("GL State Cache:");
+	ImGui::Text("Calls Skipped: %d", cacheStats.Hits);
+	ImGui::Text("Calls Issued: %d", cacheStats.Misses);
+
+	auto& tilemapStats = m_Tilemap->GetStats();
+	ImGui::Text("Tilemap Stats:");
+	ImGui::Text("Draw Calls: %d", tilemapStats.DrawCalls);
+	ImGui::Text("Culled Chunks: %d", tilemapStats.ChunksCulled);
+	ImGui::Text("Rebuilt Chunks: %d", tilemapStats.ChunksRebuilt);
 	ImGui::End();
 }
 
 void Sandbox2D::OnEvent(Engine::Event& evnt)
 {
 	m_CameraController.onEvent(evnt);
+
+	Engine::EventDispatcher dispatcher(evnt);
+	dispatcher.Dispatch<Engine::KeyPressedEvent>(ENGINE_BIND_EVENT_FN(Sandbox2D::OnKeyPressed));
+}
+
+bool Sandbox2D::OnKeyPressed(Engine::KeyPressedEvent& evnt)
+{
+	if (evnt.GetKeyCode() != Engine::Key::F2 || evnt.GetRepeatCount() > 0)
+		return false;
+
+	Engine::Application& app = Engine::Application::Get();
+	if (app.IsRenderThreadEnabled())
+		app.DisableRenderThread();
+	else
+		app.EnableRenderThread();
+	return true;
 }
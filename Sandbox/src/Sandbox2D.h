@@ -14,8 +14,21 @@ public:
 	void OnImGuiRender() override;
 	void OnEvent(Engine::Event& evnt) override;
 private:
+	bool OnKeyPressed(Engine::KeyPressedEvent& evnt);
+	// What is drawn while recording for the render thread, where Renderer2D and the other renderers are unavailable
+	void DrawRecorded();
+	// A grid of squares drawn through Renderer::Submit while the render thread runs
 	Engine::Ref<Engine::Shader> m_shader;
 	Engine::Ref<Engine::VertexArray> m_SquareVA;
+	Engine::Ref<Engine::Texture2D> m_CheckerboardTexture;
+	Engine::Ref<Engine::Texture2D> m_FaceTexture;
+	Engine::Scope<Engine::Tilemap> m_Tilemap;
+	Engine::Scope<Engine::ParticleSystem> m_ParticleSystem;
+	Engine::ParticleProps m_Particle;
+	// Runs the same emitter on the GPU next to the CPU one and compares their particle counts
+	Engine::Scope<Engine::GPUParticleSystem> m_GPUParticleSystem;
+	bool m_CompareGPUParticles = false;
+	uint32_t m_GPUParticleCount = 0;
 
 	Engine::OrthographicCameraController m_CameraController;
 	glm::vec4 m_SquareCol = glm::vec4(1.f, 1.f, 1.f, 1.f);
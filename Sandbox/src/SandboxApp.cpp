@@ -20,7 +20,12 @@ private:
 
 Sandbox::Sandbox()
 {
+#ifdef ENGINE_DEBUG
+	EnableHotReload();
+#endif
 	PushLayer(new Sandbox2D());
+	// Starts out recording for a render thread, F2 switches to the full Renderer2D scene and back
+	EnableRenderThread();
 }
 
 Sandbox::~Sandbox()